@@ -0,0 +1,205 @@
+/*
+ * Puzzle Bank
+ *
+ * Pregenerates sudoku and takuzu puzzles into a packed bank file (see
+ * lib/bank.c), so that puzzles can be served in constant time instead of
+ * running fill and mask for every request. The same tool looks puzzles up in
+ * an existing bank.
+ *
+ * Puzzle sets are written as <game>:<size>:<masked>[:<count>], e.g.
+ * "sudoku:9:40:1000" (build) or "takuzu:10:30" (lookup).
+ *
+ * Command-line options:
+ * -o <file>    Build a bank of the given sets (count is required)
+ * -j <n>       Builder threads (default: number of CPUs)
+ * -b <file>    Look up a puzzle of the given set, list the sets if none given
+ * -i <index>   Puzzle to look up (default: random)
+ * -s <seed>    Builder seed (default: 1) or seed of a random lookup (default:
+ *              current time)
+ * -a           Print the solution before the puzzle
+ *
+ * Example:
+ * ./tgbank -o bank.tgb sudoku:9:40:10000 takuzu:10:30:10000
+ * ./tgbank -b bank.tgb -i 42 sudoku:9:40
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "tinygames.h"
+
+#define MAX_SETS 64
+#define CHUNK 16  // puzzles claimed by a builder thread at a time
+
+static const char *names[] = {"sudoku", "takuzu"};
+static struct tg_bank_set set[MAX_SETS];
+static int nsets;
+static uint64_t seed = 1;
+static uint8_t *p;  // bank being built
+
+// next unclaimed puzzle, guarded by `mu`
+static int next_set;
+static uint32_t next_i;
+static pthread_mutex_t mu = PTHREAD_MUTEX_INITIALIZER;
+
+// parse "<game>:<size>:<masked>[:<count>]", return number of fields or -1
+static int parse(const char *spec, struct tg_bank_set *s) {
+  char name[16];
+  unsigned size, hide, count = 0;
+  int n = sscanf(spec, "%15[a-z]:%u:%u:%u", name, &size, &hide, &count);
+  if (n < 3) return -1;
+  for (s->game = 0; s->game < 2 && strcmp(name, names[s->game]); s->game++)
+    ;
+  s->size = size, s->hide = hide, s->count = count;
+  return tg_bank_recsize(s->game, size) ? n : -1;
+}
+
+// claim the next chunk of `n` puzzles starting at puzzle `i` of set `k`
+static int claim(int *k, uint32_t *i, uint32_t *n) {
+  pthread_mutex_lock(&mu);
+  while (next_set < nsets && next_i >= set[next_set].count) next_set++, next_i = 0;
+  int ok = next_set < nsets;
+  if (ok) {
+    *k = next_set, *i = next_i;
+    *n = set[*k].count - next_i < CHUNK ? set[*k].count - next_i : CHUNK;
+    next_i += *n;
+  }
+  pthread_mutex_unlock(&mu);
+  return ok;
+}
+
+// every puzzle has its own PRNG stream, so the bank does not depend on -j
+static void *worker(void *arg) {
+  struct tg_sudoku s = {.stats = NULL};
+  struct tg_takuzu t = {.stats = NULL};
+  int k;
+  uint32_t i, n;
+  (void)arg;
+  while (claim(&k, &i, &n)) {
+    size_t rs = tg_bank_recsize(set[k].game, set[k].size);
+    for (; n--; i++) {
+      uint8_t *rec = p + set[k].off + i * rs;
+      uint64_t stream = (uint64_t)k << 32 | i;
+      if (set[k].game == TG_BANK_SUDOKU) {
+        tg_seed(&s.rng, seed, stream);
+        tg_sudoku_fill(&s, set[k].size);
+        tg_sudoku_mask(&s, set[k].hide);
+        tg_bank_pack(TG_BANK_SUDOKU, s.w, s.g, s.a, rec);
+      } else {
+        tg_seed(&t.rng, seed, stream);
+        tg_takuzu_fill(&t, set[k].size);
+        tg_takuzu_mask(&t, set[k].hide);
+        tg_bank_pack(TG_BANK_TAKUZU, t.n, t.g, t.a, rec);
+      }
+    }
+  }
+  return NULL;
+}
+
+// write the bank to a temporary file next to `path`, rename when complete
+static int build(const char *path, int nworkers) {
+  char tmp[4096];
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  size_t len = tg_bank_layout(set, nsets, NULL);
+  snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+  int fd = open(tmp, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || ftruncate(fd, len) < 0) return perror(tmp), 1;
+  p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) return perror(tmp), 1;
+  tg_bank_layout(set, nsets, p);
+
+  pthread_t th[256];
+  if (nworkers < 1) nworkers = 1;
+  if (nworkers > 256) nworkers = 256;
+  for (int i = 0; i < nworkers; i++) pthread_create(&th[i], NULL, worker, NULL);
+  for (int i = 0; i < nworkers; i++) pthread_join(th[i], NULL);
+  if (munmap(p, len) < 0 || rename(tmp, path) < 0) return perror(path), 1;
+
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  long total = 0;
+  for (int k = 0; k < nsets; k++) total += set[k].count;
+  fprintf(stderr, "%ld puzzles, %zu bytes, %.2fs with %d threads\n", total,
+          len, t1.tv_sec - t0.tv_sec + (t1.tv_nsec - t0.tv_nsec) / 1e9,
+          nworkers);
+  return 0;
+}
+
+// Print grid `g` of `n` elements and `w` columns, `blank` is an empty cell
+static void print(const int *g, int n, int w, int blank) {
+  for (int i = 0; i < n; i++)
+    printf("%c%c", g[i] == blank ? '.' : g[i] + '0', (i + 1) % w ? ' ' : '\n');
+}
+
+int main(int argc, char *argv[]) {
+  int opt, nworkers = sysconf(_SC_NPROCESSORS_ONLN), answer = 0, seeded = 0,
+      bad = 0;
+  long index = -1;
+  char *out = NULL, *in = NULL;
+  while ((opt = getopt(argc, argv, "o:j:b:i:s:a")) != -1) {
+    switch (opt) {
+      case 'o': out = optarg; break;             // Build a bank
+      case 'j': nworkers = atoi(optarg); break;  // Builder threads
+      case 'b': in = optarg; break;              // Look up a puzzle
+      case 'i': index = atol(optarg); break;     // Puzzle index
+      case 's': seed = atoll(optarg), seeded = 1; break;  // PRNG seed
+      case 'a': answer = 1; break;               // Print solution
+      default: bad = 1;
+    }
+  }
+  if (bad || !out == !in) {
+    fprintf(stderr,
+            "USAGE: %s -o <bank> [-j <threads>] [-s <seed>] "
+            "<game>:<size>:<masked>:<count>...\n"
+            "       %s -b <bank> [-i <index>|-s <seed>] [-a] "
+            "[<game>:<size>:<masked>]\n",
+            argv[0], argv[0]);
+    return 1;
+  }
+
+  if (out) {
+    for (; optind < argc; optind++, nsets++)
+      if (nsets == MAX_SETS || parse(argv[optind], &set[nsets]) != 4 ||
+          !set[nsets].count)
+        return fprintf(stderr, "invalid puzzle set: %s\n", argv[optind]), 1;
+    return build(out, nworkers);
+  }
+
+  struct tg_bank b;
+  if (tg_bank_open(&b, in) < 0) return fprintf(stderr, "invalid bank: %s\n", in), 1;
+  if (optind == argc) {
+    for (int k = 0; k < b.nsets; k++)
+      printf("%s:%u:%u:%u\n", names[b.set[k].game], b.set[k].size,
+             b.set[k].hide, b.set[k].count);
+    return 0;
+  }
+  struct tg_bank_set want;
+  if (parse(argv[optind], &want) < 0)
+    return fprintf(stderr, "invalid puzzle set: %s\n", argv[optind]), 1;
+  int k = tg_bank_find(&b, want.game, want.size, want.hide);
+  if (k < 0) return fprintf(stderr, "no such set in %s\n", in), 1;
+  if (index < 0) {
+    struct tg_rng rng;
+    tg_seed(&rng, seeded ? seed : (uint64_t)time(0), 0);
+    index = tg_below(&rng, b.set[k].count);
+  }
+  int g[TG_TAKUZU_MAX * TG_TAKUZU_MAX], a[TG_TAKUZU_MAX * TG_TAKUZU_MAX];
+  if (index >= b.set[k].count)
+    return fprintf(stderr, "index out of range: %ld\n", index), 1;
+  int n = tg_bank_get(&b, k, index, g, a);
+  int blank = want.game == TG_BANK_SUDOKU ? 0 : -1;
+  if (answer) {
+    print(a, n, want.size, blank);  // Print solution if requested
+    printf("\n");
+  }
+  print(g, n, want.size, blank);
+  return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * Tiny Games Benchmark
+ *
+ * Runs fixed-seed workloads against libtinygames and prints one JSON object
+ * with ops/sec, latency percentiles and peak RSS for every workload, so that
+ * results can be compared between commits. Every workload runs in its own
+ * child process, so its peak RSS is not inherited from earlier ones.
+ *
+ * Command-line options:
+ * -d <file>    Wordle dictionary (default: ../wordle/WORDS.txt)
+ * -f <name>    Only run workloads whose name contains this string
+ * -x <scale>   Multiply the number of ops of every workload (default: 1)
+ */
+#define _GNU_SOURCE
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "tinygames.h"
+
+static struct tg_dict dict;
+static const char *filter = "";
+static int scale = 1, first = 1;
+
+static long long now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int cmp(const void *a, const void *b) {
+  return (*(long long *)a > *(long long *)b) - (*(long long *)a < *(long long *)b);
+}
+
+// a workload runs op(i, arg) for i = 0..n-1, each op must be deterministic
+typedef void (*op_fn)(int i, int arg);
+
+// op results are accumulated here so the compiler can't drop the work
+static volatile long sink;
+
+// each workload runs in a forked child, so that its peak RSS is its own and
+// not the high-water mark of all workloads before it
+static void run(const char *name, const char *params, op_fn op, int arg, int n) {
+  if (!strstr(name, filter)) return;
+  n *= scale;
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid == 0) {
+    long long *lat = malloc(sizeof(long long) * n), total = 0;
+    for (int i = 0; i < n; i++) {
+      long long t0 = now_ns();
+      op(i, arg);
+      total += lat[i] = now_ns() - t0;
+    }
+    qsort(lat, n, sizeof(long long), cmp);
+    printf("%s\n    {\"name\": \"%s\", \"params\": \"%s\", \"ops\": %d, "
+           "\"ops_per_sec\": %.1f, \"p50_us\": %.1f, \"p90_us\": %.1f, "
+           "\"p99_us\": %.1f, \"max_us\": %.1f",
+           first ? "" : ",", name, params, n, n * 1e9 / total,
+           lat[n * 50 / 100] / 1e3, lat[n * 90 / 100] / 1e3,
+           lat[n * 99 / 100] / 1e3, lat[n - 1] / 1e3);
+    fflush(stdout);
+    _exit(0);
+  }
+  struct rusage ru;
+  int status;
+  if (pid < 0 || wait4(pid, &status, 0, &ru) < 0 || !WIFEXITED(status) ||
+      WEXITSTATUS(status)) {
+    fprintf(stderr, "workload %s (%s) failed\n", name, params);
+    exit(1);
+  }
+  printf(", \"peak_rss_kb\": %ld}", ru.ru_maxrss);
+  first = 0;
+}
+
+// sudoku: fill and mask, arg = width * 100 + masked cells
+static void sudoku(int i, int arg) {
+  struct tg_sudoku s = {.stats = NULL};
+  tg_seed(&s.rng, i, 0);
+  tg_sudoku_fill(&s, arg / 100);
+  tg_sudoku_mask(&s, arg % 100);
+  sink += s.g[0];
+}
+
+// takuzu: fill and mask 20 cells (the CLI default), arg = size
+static void takuzu(int i, int arg) {
+  struct tg_takuzu t = {.stats = NULL};
+  tg_seed(&t.rng, i, 0);
+  tg_takuzu_fill(&t, arg);
+  tg_takuzu_mask(&t, 20);
+  sink += t.g[0];
+}
+
+// countdown: solve a generated set of `arg` numbers (2 big ones)
+static void countdown(int i, int arg) {
+  struct tg_countdown c;
+  int e[TG_COUNTDOWN_EXPR], len;
+  tg_seed(&c.rng, i, 0);
+  tg_countdown_gen(&c, arg, 2);
+  sink += tg_countdown_solve(c.nums, c.n, c.target, e, &len, NULL);
+}
+
+// chess: fixed-depth negamax from the initial position, arg = mode * 10 + depth
+static void chess(int i, int arg) {
+  struct tg_chess c = {.stats = NULL};
+  int best = 0;
+  (void)i;
+  tg_chess_init(&c, arg / 10);
+  sink += tg_chess_negamax(&c, arg % 10, &best) + best;
+}
+
+// wordle: score every word of the same length against the i-th one
+static void wordle(int i, int arg) {
+  char h[TG_WORD_LEN];
+  const char *secret = dict.w[i % dict.n];
+  (void)arg;
+  for (int j = 0; j < dict.n; j++)
+    if (strlen(dict.w[j]) == strlen(secret))
+      sink += tg_wordle_score(dict.w[j], secret, h);
+}
+
+int main(int argc, char *argv[]) {
+  int opt;
+  char *path = "../wordle/WORDS.txt", params[64];
+  while ((opt = getopt(argc, argv, "d:f:x:")) != -1) {
+    switch (opt) {
+      case 'd': path = optarg; break;         // Wordle dictionary
+      case 'f': filter = optarg; break;       // Workload name filter
+      case 'x': scale = atoi(optarg); break;  // Ops multiplier
+      default:
+        fprintf(stderr, "USAGE: %s [-d <dict>] [-f <name>] [-x <scale>]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (scale < 1) scale = 1;
+
+  printf("{\n  \"benchmarks\": [");
+  static const int SUDOKU[][3] = {{4, 6, 10}, {6, 12, 20}, {9, 30, 50}};
+  for (int i = 0; i < 3; i++)
+    for (int j = 1; j < 3; j++) {
+      snprintf(params, sizeof(params), "w=%d m=%d", SUDOKU[i][0], SUDOKU[i][j]);
+      run("sudoku", params, sudoku, SUDOKU[i][0] * 100 + SUDOKU[i][j], 200);
+    }
+  for (int n = 8; n <= 20; n += 2) {
+    snprintf(params, sizeof(params), "n=%d m=20", n);
+    run("takuzu", params, takuzu, n, 100);
+  }
+  for (int n = 4; n <= 6; n++) {
+    snprintf(params, sizeof(params), "n=%d b=2", n);
+    run("countdown", params, countdown, n, n < 6 ? 200 : 20);
+  }
+  for (int mode = 4; mode <= 6; mode++) {
+    snprintf(params, sizeof(params), "n=%d depth=4", mode);
+    run("chess", params, chess, mode * 10 + 4, 20);
+  }
+  if (strstr("wordle", filter)) {
+    if (tg_dict_load(&dict, path) <= 0) return perror(path), 1;
+    snprintf(params, sizeof(params), "words=%d", dict.n);
+    run("wordle", params, wordle, 0, 200);
+  }
+  struct rusage ru;
+  getrusage(RUSAGE_CHILDREN, &ru);  // the largest of all workloads
+  printf("\n  ],\n  \"peak_rss_kb\": %ld\n}\n", ru.ru_maxrss);
+  return 0;
+}
@@ -2,18 +2,16 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include "tinygames.h"
+
 int main(void) {
-    char s[5], g[5]; int b, c, i, j;
-    srand(time(0));
-    for (i = 0; i < 4; s[i++] = '0' + rand() % 10) for (j = 0; j < i; j++) if (s[j] == s[i]) i--;
-    s[4] = '\0';
+    char s[5], g[5]; int b, c;
+    struct tg_rng r;
+    tg_seed(&r, time(0), 0);
+    tg_bullscows_gen(s, &r);
     while (1) {
-        printf("> "); scanf("%4s", g);
-        for (b = c = i = 0; i < 4; i++) {
-            if (s[i] == g[i]) b++;
-            for (j = 0; j < 4; j++) if (i != j && s[i] == g[j]) c++;
-        }
-        if (b == 4) { printf("You win!\n"); break; }
+        printf("> "); if (scanf("%4s", g) != 1) break;
+        if (tg_bullscows_score(s, g, &b, &c)) { printf("You win!\n"); break; }
         printf("%d bulls, %d cows\n", b, c);
     }
     return 0;
@@ -1,117 +1,118 @@
+#define _GNU_SOURCE
+#include <getopt.h>
+#include <poll.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/select.h>
-#include <sys/time.h>
+#include <sys/timerfd.h>
 #include <termios.h>
 #include <time.h>
 #include <unistd.h>
 
-// great theory:
-// https://www.petercollingridge.co.uk/blog/mathematics-toys-and-games/dobble/
+#include "tinygames.h"
 
-const char *e[] = {"🍎", "🍌", "🍇", "🍒", "🍓", "🥝", "🍑", "🍍", "🥥",
-                   "🥕", "🌻", "🌈", "⚽", "🏀", "🎸", "🎲", "🎯", "🧩",
-                   "📚", "✂️",  "🖌️", "🔧", "🔑", "🔋", "💡", "📞", "🕰️",
-                   "📷", "🎥", "🚗", "🚲", "🚀", "🎈", "🌟", "🔥", "⛄",
-                   "🦋", "🐞", "🐟", "🐘", "🐱", "🐶", "🦊", "🐼", "🦄",
-                   "🦉", "🌳", "🌵", "🏔️", "⚓", "🛸", "🎷", "📀", "💎",
-                   "🔭", "🌌", "🐢", "🐍", "🦜", "🍤", "🎡", "🏖️", "📡"};
-const char *C[999];  // full card deck
-int N = 6;           // symbols on a card Junior:6, Full:8
-#define SZ \
-  (N * N - N + 1)  // number of cards in a deck for N symbols per card
-                   //
-                   // shuffle int array of n elements
-void shuffle(int *a, int n) {
-  for (int i = 0, j, t; i < n; i++)
-    j = rand() % n, t = a[i], a[i] = a[j], a[j] = t;
-}
-
-// generate a proper deck of cards, N symbols each.
-// any two cards have one, and only one symbol in common.
-void gencards() {
-  int n = N - 1;
-  const char **c = C;
-  for (int i = 0; i <= n; i++) *c++ = e[i];
-  for (int j = 0; j < n; j++) {
-    *c++ = e[0];
-    for (int k = 0; k < n; k++) *c++ = e[n + 1 + n * j + k];
-  }
-  for (int i = 0; i < n; i++) {
-    for (int j = 0; j < n; j++) {
-      *c++ = e[i + 1];
-      for (int k = 0; k < n; k++) *c++ = e[n + 1 + n * k + (i * k + j) % n];
-    }
-  }
-  for (int i = 0; i < SZ; i++) {
-    for (int j = 0; j < N; j++) {
-      int k = rand() % N;
-      const char *tmp = C[i * N + j];
-      C[i * N + j] = C[i * N + k], C[i * N + k] = tmp;
-    }
-  }
-}
+struct tg_dobble d;  // card deck
 
 // print i-th card from deck with some prefix
 void printcard(const char *prefix, int i) {
   printf("%s", prefix);
-  for (int j = 0; j < N; j++) printf("%s ", C[i * N + j]);
+  for (int j = 0; j < d.n; j++) printf("%s ", d.c[i * d.n + j]);
   printf("\n");
 }
 
-// return a symbol, common between i-th and j-th cards in deck
-const char *match(int i, int j) {
-  for (int x = 0; x < N; x++)
-    for (int y = 0; y < N; y++)
-      if (strcmp(C[i * N + x], C[j * N + y]) == 0) return C[i * N + x];
-  return NULL;
+// monotonic clock in milliseconds
+long long now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
 }
 
-// read a digit 1..n during the timeout (in 0.1s units)
-int input(int n, int timeout) {
+// read a digit 1..n during the timeout (in ms), store reaction time in `ms`.
+// returns -1 on timeout and 0 on end of input. when stdin is not a terminal
+// (scripted input from a pipe) there is no raw mode and no spinner.
+int input(int n, int timeout, int *ms) {
   struct termios orig, term;
-  int k = -1;
-  tcgetattr(STDIN_FILENO, &orig);
-  term = orig;
-  term.c_lflag &= ~(ICANON | ECHO);
-  tcsetattr(STDIN_FILENO, TCSANOW, &term);
-  for (int i = 0; i < timeout; i++) {
-    printf("\r%c Symbol (1-%d)? ", "\\|//-"[i % 4], n);
-    fflush(stdout);
-    struct timespec ts = {0, 100000000L};  // 0.1s
-    nanosleep(&ts, NULL);
-    fd_set readfds;
-    struct timeval tv = {0, 0};
-    FD_ZERO(&readfds);
-    FD_SET(STDIN_FILENO, &readfds);
-    if (select(STDIN_FILENO + 1, &readfds, NULL, NULL, &tv) > 0) {
+  int k = -1, tty = isatty(STDIN_FILENO), tfd = -1, frame = 0;
+  long long start = now(), left;
+  if (tty) {
+    tcgetattr(STDIN_FILENO, &orig);
+    term = orig;
+    term.c_lflag &= ~(ICANON | ECHO);
+    tcsetattr(STDIN_FILENO, TCSANOW, &term);
+    struct itimerspec its = {{0, 100000000L}, {0, 1}};  // spinner: 0.1s
+    tfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    timerfd_settime(tfd, 0, &its, NULL);
+  }
+  while (k < 0 && (left = start + timeout - now()) > 0) {
+    struct pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {tfd, POLLIN, 0}};
+    if (poll(fds, tfd < 0 ? 1 : 2, left) <= 0) continue;  // timeout or EINTR
+    if (fds[1].revents & POLLIN) {
+      uint64_t ticks;
+      if (read(tfd, &ticks, sizeof(ticks)) == sizeof(ticks)) frame += ticks;
+      printf("\r%c Symbol (1-%d)? ", "\\|//-"[frame % 4], n);
+      fflush(stdout);
+    }
+    if (fds[0].revents & (POLLIN | POLLHUP)) {
       char c;
-      if (read(STDIN_FILENO, &c, 1) == 1 && c >= '1' && c <= '0' + n) {
+      if (read(STDIN_FILENO, &c, 1) != 1) {
+        k = 0;  // end of input
+      } else if (c >= '1' && c <= '0' + n) {
         k = c - '0';
-        break;
+        *ms = now() - start;
       }
     }
   }
-  printf("\r                              \r");
-  tcsetattr(STDIN_FILENO, TCSANOW, &orig);
+  if (tty) {
+    printf("\r                              \r");
+    tcsetattr(STDIN_FILENO, TCSANOW, &orig);
+    close(tfd);
+  }
   return k;
 }
 
-int main() {
-  int deck[SZ], won = 0, top = 0;
-  srand(time(0));
-  gencards();
-  for (int i = 0; i < SZ; i++) deck[i] = i;
-  shuffle(deck, SZ);
-  for (int i = 1; i < SZ; i++) {
+int cmp(const void *a, const void *b) { return *(int *)a - *(int *)b; }
+
+// print reaction time percentiles of `n` samples (sorts `a` in place)
+void stats(int *a, int n) {
+  if (!n) return;
+  qsort(a, n, sizeof(int), cmp);
+  printf("Reaction (ms): min %d, p50 %d, p90 %d, p99 %d, max %d\n", a[0],
+         a[n * 50 / 100], a[n * 90 / 100], a[n * 99 / 100], a[n - 1]);
+}
+
+int main(int argc, char *argv[]) {
+  int won = 0, top = 0, opt, seed = time(0), timeout = 10000, N = 6;
+  int rt[57], nrt = 0;  // reaction times (ms) for answered cards
+  int played;           // cards dealt to the player
+  while ((opt = getopt(argc, argv, "n:s:t:")) != -1) {
+    switch (opt) {
+      case 'n': N = atoi(optarg); break;               // Symbols per card
+      case 's': seed = atoi(optarg); break;            // PRNG seed
+      case 't': timeout = atoi(optarg) * 1000; break;  // Seconds per card
+      default:
+        fprintf(stderr, "USAGE: %s [-n 6|8] [-s <seed>] [-t <timeout>]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  tg_seed(&d.rng, seed, 0);
+  if (tg_dobble_init(&d, N) < 0) return fprintf(stderr, "invalid -n %d\n", N), 1;
+  int *deck = d.deck, sz = d.sz;
+  played = sz - 1;
+  for (int i = 1; i < sz; i++) {
     printcard("Top: ", deck[top]);
     printcard("You: ", deck[i]);
-    const char *answer = match(deck[i], deck[top]);
-    int sym = input(N, 100);
+    const char *answer = tg_dobble_match(&d, deck[i], deck[top]);
+    int ms, sym = input(N, timeout, &ms);
+    if (sym == 0) {  // no more input, cards not played yet don't count
+      played = i - 1;
+      break;
+    }
     if (sym > 0) {
-      if (strcmp(answer, C[N * deck[i] + sym - 1]) == 0) {
-        printf("Correct %s %s!\n\n", answer, C[N * deck[i] + sym - 1]);
+      rt[nrt++] = ms;
+      if (strcmp(answer, d.c[N * deck[i] + sym - 1]) == 0) {
+        printf("Correct %s %s!\n\n", answer, d.c[N * deck[i] + sym - 1]);
         top = i;
         won++;
       } else {
@@ -125,9 +126,12 @@ int main() {
       i++;
     }
   }
-  if (won >= (SZ - 1) / 2)
-    printf("You won: %d vs %d\n", won, SZ - won - 1);
+  if (!played)
+    printf("No cards played\n");
+  else if (won >= played / 2)
+    printf("You won: %d vs %d\n", won, played - won);
   else
-    printf("You lost: %d vs %d\n", won, SZ - won - 1);
+    printf("You lost: %d vs %d\n", won, played - won);
+  stats(rt, nrt);
   return 0;
 }
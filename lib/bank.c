@@ -0,0 +1,119 @@
+/*
+ * Puzzle bank file, integers in host byte order:
+ *
+ *   header   "TGBANK\0\0", u32 version, u32 number of sets
+ *   sets     u32 game, u32 size, u32 hide, u32 count, u64 offset (per set)
+ *   records  `count` fixed-size records per set, starting at `offset`
+ *
+ * A record is the puzzle followed by its solution, cell by cell, packed LSB
+ * first: 4 bits per cell for sudoku (0 is blank), 2 bits per cell for takuzu
+ * (2 is blank), padded to a whole byte. Puzzle `i` of a set is at
+ * offset + i * record size, so a lookup is a single multiply.
+ */
+#define _DEFAULT_SOURCE
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tinygames.h"
+
+#define MAGIC "TGBANK\0\0"
+#define VERSION 1  // also rejects files written with the other byte order
+
+struct header {
+  char magic[8];
+  uint32_t version, nsets;
+};
+
+static int bits(int game) { return game == TG_BANK_SUDOKU ? 4 : 2; }
+
+size_t tg_bank_recsize(int game, int size) {
+  int ok = game == TG_BANK_SUDOKU ? size == 4 || size == 6 || size == 9
+           : game == TG_BANK_TAKUZU
+               ? size >= 2 && size % 2 == 0 && size <= TG_TAKUZU_MAX
+               : 0;
+  return ok ? (2 * size * size * bits(game) + 7) / 8 : 0;
+}
+
+void tg_bank_pack(int game, int size, const int *g, const int *a, uint8_t *rec) {
+  int b = bits(game), n = size * size;
+  memset(rec, 0, tg_bank_recsize(game, size));
+  for (int k = 0; k < 2 * n; k++) {
+    int v = k < n ? g[k] : a[k - n];
+    if (v < 0) v = 2;  // takuzu blank
+    rec[k * b / 8] |= v << (k * b % 8);
+  }
+}
+
+size_t tg_bank_layout(struct tg_bank_set *set, int nsets, uint8_t *p) {
+  size_t off = sizeof(struct header) + nsets * sizeof(*set);
+  for (int i = 0; i < nsets; i++) {
+    set[i].off = off;
+    off += set[i].count * tg_bank_recsize(set[i].game, set[i].size);
+  }
+  if (p) {
+    struct header h = {MAGIC, VERSION, nsets};
+    memcpy(p, &h, sizeof(h));
+    memcpy(p + sizeof(h), set, nsets * sizeof(*set));
+  }
+  return off;
+}
+
+int tg_bank_open(struct tg_bank *b, const char *path) {
+  struct stat st;
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return -1;
+  if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(struct header)) {
+    close(fd);
+    return -1;
+  }
+  b->len = st.st_size;
+  b->p = mmap(NULL, b->len, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (b->p == MAP_FAILED) return -1;
+  const struct header *h = (const struct header *)b->p;
+  b->nsets = h->nsets;
+  b->set = (const struct tg_bank_set *)(b->p + sizeof(*h));
+  // reject anything that would make a lookup read outside the mapping
+  int ok = !memcmp(h->magic, MAGIC, 8) && h->version == VERSION &&
+           h->nsets <= (b->len - sizeof(*h)) / sizeof(*b->set);
+  for (int i = 0; ok && i < b->nsets; i++) {
+    size_t rs = tg_bank_recsize(b->set[i].game, b->set[i].size);
+    ok = rs && b->set[i].off <= b->len &&
+         b->set[i].count <= (b->len - b->set[i].off) / rs;
+  }
+  if (!ok) {
+    tg_bank_close(b);
+    return -1;
+  }
+  return 0;
+}
+
+void tg_bank_close(struct tg_bank *b) {
+  munmap((void *)b->p, b->len);
+  b->p = NULL, b->len = 0, b->nsets = 0;
+}
+
+int tg_bank_find(const struct tg_bank *b, int game, int size, int hide) {
+  for (int i = 0; i < b->nsets; i++)
+    if (b->set[i].game == (uint32_t)game && b->set[i].size == (uint32_t)size &&
+        b->set[i].hide == (uint32_t)hide && b->set[i].count)
+      return i;
+  return -1;
+}
+
+int tg_bank_get(const struct tg_bank *b, int set, uint32_t i, int *g, int *a) {
+  if (set < 0 || set >= b->nsets || i >= b->set[set].count) return -1;
+  const struct tg_bank_set *s = &b->set[set];
+  int game = s->game, n = s->size * s->size, w = bits(game);
+  const uint8_t *rec = b->p + s->off + i * tg_bank_recsize(game, s->size);
+  for (int k = 0; k < 2 * n; k++) {
+    int v = rec[k * w / 8] >> (k * w % 8) & ((1 << w) - 1);
+    if (game == TG_BANK_TAKUZU && v == 2) v = -1;
+    if (k < n) g[k] = v;
+    else a[k - n] = v;
+  }
+  return n;
+}
@@ -0,0 +1,21 @@
+#include "tinygames.h"
+
+void tg_bullscows_gen(char s[5], struct tg_rng *r) {
+  for (int i = 0, j; i < 4; i += j == i) {  // redraw on repeated digit
+    s[i] = '0' + tg_below(r, 10);
+    for (j = 0; j < i && s[j] != s[i]; j++) {
+    }
+  }
+  s[4] = '\0';
+}
+
+int tg_bullscows_score(const char *s, const char *g, int *bulls, int *cows) {
+  int b = 0, c = 0;
+  for (int i = 0; i < 4; i++) {
+    if (s[i] == g[i]) b++;
+    for (int j = 0; j < 4; j++)
+      if (i != j && s[i] == g[j]) c++;
+  }
+  *bulls = b, *cows = c;
+  return b == 4;
+}
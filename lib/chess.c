@@ -0,0 +1,115 @@
+#include <string.h>
+
+#include "tinygames.h"
+
+//
+// board representation:
+//
+// +-------------------+-------+
+// | 00 01 02 03 04 05 | 06 07 |
+// | 08 09 10 11 12 13 | 14 15 |
+// | 16 17 18 19 20 21 | 22 23 |
+// | 24 25 26 27 28 29 | 30 31 |
+// | 32 33 34 35*36 37 | 38 39 |
+// | 40 41 42 43 44 45 | 46 47 |
+// +-------------------+-------+
+//
+// pieces notation PNKBRQ + . (empty)
+//   N[p+6]   piece symbol
+//   p>0      player's piece
+//   p<0      opponent's piece
+//   p>3      sliding piece
+//   !p       empty square
+//   -p       toggle side (player/opponent)
+const char *tg_chess_pieces = "qrbknp.PNKBRQ";
+
+// piece step vectors: +1/-1 = horisontal, +8/-8 = vertical, -7/-9/+7/+9 = diagonal
+// vectors must be null-terminated
+static const int D[5][9] = {
+	{-17, - 15, -6, -10, 6, 10, 15, 17, 0}, // N
+	{-7, -8, -9, -1, 1, 7, 8, 9, 0}, // K
+	{-7, -9, 7, 9, 0}, // B
+	{-8, -1, 1, 8, 0}, // R
+	{-7, -8, -9, -1, 1, 7, 8, 9, 0}, // Q
+};
+
+// parse FEN (assuming it's valid)
+static void fen(struct tg_chess *c, const char *s) {
+	memset(c->b, 0, sizeof(c->b));
+	for (int i = 0; *s && *s != ' '; s++)
+		if (*s == '/')  i = (i/8+1)*8;
+		else if (*s > 'A') c->b[i++] = strchr(tg_chess_pieces, *s) - tg_chess_pieces - 6;
+		else if (*s > '0') i += *s - '0';
+}
+
+int tg_chess_init(struct tg_chess *c, int mode) {
+	c->sp = c->m;
+	if (mode == 6) c->w = 6, c->h = 6, c->e=46, fen(c, "rnqknr/pppppp/6/6/PPPPPP/RNQKNR");
+	else if (mode == 4) c->w = 4, c->h = 5, c->e=36, fen(c, "kbnr/p3/4/3P/RNBK");
+	else if (mode == 5) c->w = 5, c->h = 5, c->e=37, fen(c, "rnbqk/ppppp/5/PPPPP/RNBQK");
+	else return -1;
+	return 0;
+}
+
+void tg_chess_flip(struct tg_chess *c) {
+	int *B = c->b;
+	for (int i=0,j=c->e-1,t; i<(c->e+1)/2; i++,j--) t=B[i], B[i]=-B[j], B[j]=-t;
+}
+
+// appends all valid player moves to the move stack
+void tg_chess_moves(struct tg_chess *c) {
+	int *B = c->b;
+	for (int i = 0, p; i < c->e; i++) { // check every square in the playing area
+		if ((p = B[i]) > 0) { // player's piece?
+			if (p > 1) { // not a pawn?
+				for (const int *d = D[p-2]; *d; d++) {
+					for (int step = 0, to=i+*d; step < (p>3?6:1); to+=*d,step++) {
+						if (to < 0 || to >= c->e || to % 8 >= c->w || B[to] > 0) break; // invalid or player's piece
+						*c->sp++ = (i<<8)|to; // store valid move (from+to)
+						if (B[to] < 0) break; // capture, stop sliding
+					}
+				}
+			} else { // pawn: very different form other pieces
+				if (i>8 && B[i-9]<0) *c->sp++ = (i<<8)|(i-9); // capture up+left
+				if (i>7 && B[i-7]<0) *c->sp++ = (i<<8)|(i-7); // capture up+rigth
+				if (i>8 && !B[i-8]) *c->sp++ = (i<<8)|(i-8);  // move ahead (+promition)
+			}
+		}
+	}
+}
+
+// current board score
+int tg_chess_eval(const struct tg_chess *c) {
+	static const int V[]={-9,-5,-3,-999,-3,-1,0,1,3,999,3,5,9};
+	int score = 0;
+	TG_COUNT(c->stats, checks);
+	for (int i = 0; i < c->e; i++) score += V[c->b[i]+6];
+	return score;
+}
+
+// apply move to the board, return captured piece, if any
+int tg_chess_move(struct tg_chess *c, int m) {
+	int from = m >> 8, to = m & 0xff, capture = c->b[to];
+	// TODO: handle pawn promotion to queen
+	c->b[to] = c->b[from]; c->b[from] = 0;
+	return capture;
+}
+
+int tg_chess_negamax(struct tg_chess *c, int depth, int *best) {
+	TG_COUNT(c->stats, calls);
+	if (!depth) return tg_chess_eval(c);
+	int *start = c->sp, *end, max = -999, tmp;
+	tg_chess_moves(c);
+	end = c->sp;
+	for (int *n = start; n < end; n++) {
+		int captured = tg_chess_move(c, *n), score;
+		TG_COUNT(c->stats, nodes);
+		tg_chess_flip(c);
+		score = -tg_chess_negamax(c, depth - 1, &tmp);
+		tg_chess_flip(c);
+		c->b[*n>>8] = c->b[*n&0xff], c->b[*n&0xff] = captured;
+		if (score >= max) max = score, *best = *n;
+	}
+	c->sp = start;
+	return max;
+}
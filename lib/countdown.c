@@ -0,0 +1,114 @@
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tinygames.h"
+
+int tg_countdown_calc(const int *e, int len) {
+  int stack[TG_COUNTDOWN_EXPR], sp = 0;
+  for (int i = 0; i < len; i++) {
+    if (e[i] > 0) {
+      if (sp == TG_COUNTDOWN_EXPR) return -1;
+      stack[sp++] = e[i];
+    } else {
+      if (sp < 2) return -1;
+      int b = stack[--sp], a = stack[--sp], result;
+      switch (e[i]) {
+        case -1: result = a + b; break;
+        case -2: result = a - b; break;
+        case -3: result = a * b; break;
+        case -4: result = (b == 0 || a % b != 0) ? -1 : a / b; break;
+        default: return -1;
+      }
+      if (result <= 0) return -1;
+      stack[sp++] = result;
+    }
+  }
+  return (sp == 1) ? stack[0] : -1;
+}
+
+int tg_countdown_gen(struct tg_countdown *c, int n, int big) {
+  static const int BIG[4] = {25, 50, 75, 100};
+  if (n < 2 || n > TG_COUNTDOWN_MAX || big < 0 || big > n) return -1;
+  c->n = n;
+  for (int i = 0; i < big; i++) c->nums[i] = BIG[tg_below(&c->rng, 4)];
+  for (int i = big; i < n; i++) c->nums[i] = tg_below(&c->rng, 10) + 1;
+  for (int tries = 0; tries < 100000; tries++) {
+    memcpy(c->hint, c->nums, sizeof(int) * n);
+    tg_shuffle(&c->rng, c->hint, n);
+    for (int i = 0; i < n - 1; i++) c->hint[n + i] = -(int)tg_below(&c->rng, 4) - 1;
+    c->hlen = n * 2 - 1;
+    c->target = tg_countdown_calc(c->hint, c->hlen);
+    if (c->target > 100 && c->target < 999) return c->target;
+  }
+  return -1;  // numbers too small to reach any target
+}
+
+// Recursive function to solve the countdown problem and track the closest
+// result
+static int solve_r(const int *nums, int n, int target, int *expr, int pos,
+                   int *best_diff, int *best_expr, int *best_pos,
+                   struct tg_stats *stats) {
+  TG_COUNT(stats, calls);
+  if (n == 1) {
+    TG_COUNT(stats, checks);
+    int diff = abs(nums[0] - target);
+    if (diff < *best_diff) {
+      *best_diff = diff;
+      memcpy(best_expr, expr, pos * sizeof(int));  // Save best expression
+      *best_pos = pos;
+      best_expr[pos] = nums[0];  // Save the final number
+    }
+    return (nums[0] == target);
+  }
+
+  // Try all pairs of numbers
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (i == j) continue;
+      int a = nums[i], b = nums[j];
+      int rest[TG_COUNTDOWN_MAX], restIdx = 0;
+
+      // Prepare remaining numbers
+      for (int k = 0; k < n; k++)
+        if (k != i && k != j) rest[restIdx++] = nums[k];
+
+      // Try all operations
+      for (int op = -1; op >= -4; op--) {
+        int result;
+        switch (op) {
+          case -1: result = a + b; break;
+          case -2: result = a - b; break;
+          case -3: result = a * b; break;
+          default: result = (b == 0 || a % b) ? -1 : a / b; break;  // Invalid division
+        }
+        if (result <= 0) {
+          TG_COUNT(stats, prunes);
+          continue;
+        }
+        TG_COUNT(stats, nodes);
+
+        // Add result and operation to expression
+        rest[restIdx] = result;
+        expr[pos] = a;
+        expr[pos + 1] = b;
+        expr[pos + 2] = op;
+
+        // Recursively solve for remaining numbers
+        if (solve_r(rest, restIdx + 1, target, expr, pos + 3, best_diff,
+                    best_expr, best_pos, stats))
+          return 1;  // Exact solution found
+      }
+    }
+  }
+  return 0;
+}
+
+int tg_countdown_solve(const int *nums, int n, int target, int *e, int *len,
+                       struct tg_stats *stats) {
+  int expr[TG_COUNTDOWN_EXPR], best_diff = INT_MAX, best_pos = 0;
+  if (n < 1 || n > TG_COUNTDOWN_MAX) return -1;
+  solve_r(nums, n, target, expr, 0, &best_diff, e, &best_pos, stats);
+  *len = best_pos + 1;
+  return best_diff;
+}
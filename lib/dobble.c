@@ -0,0 +1,52 @@
+#include <string.h>
+
+#include "tinygames.h"
+
+// great theory:
+// https://www.petercollingridge.co.uk/blog/mathematics-toys-and-games/dobble/
+
+static const char *e[] = {"🍎", "🍌", "🍇", "🍒", "🍓", "🥝", "🍑", "🍍", "🥥",
+                          "🥕", "🌻", "🌈", "⚽", "🏀", "🎸", "🎲", "🎯", "🧩",
+                          "📚", "✂️",  "🖌️", "🔧", "🔑", "🔋", "💡", "📞", "🕰️",
+                          "📷", "🎥", "🚗", "🚲", "🚀", "🎈", "🌟", "🔥", "⛄",
+                          "🦋", "🐞", "🐟", "🐘", "🐱", "🐶", "🦊", "🐼", "🦄",
+                          "🦉", "🌳", "🌵", "🏔️", "⚓", "🛸", "🎷", "📀", "💎",
+                          "🔭", "🌌", "🐢", "🐍", "🦜", "🍤", "🎡", "🏖️", "📡"};
+
+// generate a proper deck of cards, N symbols each.
+// any two cards have one, and only one symbol in common.
+int tg_dobble_init(struct tg_dobble *d, int N) {
+  if (N != 6 && N != 8) return -1;
+  int n = N - 1;
+  const char **c = d->c;
+  d->n = N, d->sz = N * N - N + 1;
+  for (int i = 0; i <= n; i++) *c++ = e[i];
+  for (int j = 0; j < n; j++) {
+    *c++ = e[0];
+    for (int k = 0; k < n; k++) *c++ = e[n + 1 + n * j + k];
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      *c++ = e[i + 1];
+      for (int k = 0; k < n; k++) *c++ = e[n + 1 + n * k + (i * k + j) % n];
+    }
+  }
+  for (int i = 0; i < d->sz; i++) {
+    int order[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    const char *card[8];
+    tg_shuffle(&d->rng, order, N);  // shuffle symbols on each card
+    for (int j = 0; j < N; j++) card[j] = d->c[i * N + order[j]];
+    memcpy(&d->c[i * N], card, sizeof(*card) * N);
+    d->deck[i] = i;
+  }
+  tg_shuffle(&d->rng, d->deck, d->sz);
+  return 0;
+}
+
+const char *tg_dobble_match(const struct tg_dobble *d, int i, int j) {
+  for (int x = 0; x < d->n; x++)
+    for (int y = 0; y < d->n; y++)
+      if (strcmp(d->c[i * d->n + x], d->c[j * d->n + y]) == 0)
+        return d->c[i * d->n + x];
+  return NULL;
+}
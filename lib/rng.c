@@ -0,0 +1,32 @@
+#include "tinygames.h"
+
+// PCG32 (XSH RR), see https://www.pcg-random.org/
+uint32_t tg_rand(struct tg_rng *r) {
+  uint64_t old = r->state;
+  r->state = old * 6364136223846793005ULL + r->inc;
+  uint32_t x = ((old >> 18) ^ old) >> 27, rot = old >> 59;
+  return (x >> rot) | (x << (-rot & 31));
+}
+
+void tg_seed(struct tg_rng *r, uint64_t seed, uint64_t stream) {
+  r->state = 0;
+  r->inc = (stream << 1) | 1;  // stream selects the increment, must be odd
+  tg_rand(r);
+  r->state += seed;
+  tg_rand(r);
+}
+
+// Lemire's multiply-shift with rejection, no modulo bias
+uint32_t tg_below(struct tg_rng *r, uint32_t n) {
+  uint64_t m = (uint64_t)tg_rand(r) * n;
+  if ((uint32_t)m < n) {
+    uint32_t t = -n % n;
+    while ((uint32_t)m < t) m = (uint64_t)tg_rand(r) * n;
+  }
+  return m >> 32;
+}
+
+void tg_shuffle(struct tg_rng *r, int *a, int n) {
+  for (int i = n - 1, j, t; i > 0; i--)
+    j = tg_below(r, i + 1), t = a[i], a[i] = a[j], a[j] = t;
+}
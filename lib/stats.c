@@ -0,0 +1,31 @@
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+
+#include "stats.h"
+
+static long long now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void tg_stats_start(struct tg_stats *s, int phase) {
+  if (s) s->t0[phase] = now_ns();
+}
+
+void tg_stats_stop(struct tg_stats *s, int phase) {
+  if (s) s->ns[phase] += now_ns() - s->t0[phase];
+}
+
+void tg_stats_print(const struct tg_stats *s, FILE *f) {
+  static const char *phases[TG_PHASES] = {"fill", "mask", "search"};
+#ifdef TG_NO_STATS
+  fprintf(f, "stats: counters compiled out\n");
+#else
+  fprintf(f, "stats: calls %ld, nodes %ld, backtracks %ld, checks %ld, "
+          "prunes %ld\n", s->calls, s->nodes, s->backtracks, s->checks,
+          s->prunes);
+#endif
+  for (int i = 0; i < TG_PHASES; i++)
+    if (s->ns[i]) fprintf(f, "time: %s %.3f ms\n", phases[i], s->ns[i] / 1e6);
+}
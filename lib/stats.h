@@ -0,0 +1,37 @@
+#ifndef TG_STATS_H
+#define TG_STATS_H
+
+/*
+ * Hot-path counters and per-phase timers behind the --stats switch.
+ *
+ * Game contexts carry a `struct tg_stats *stats` pointer, NULL when stats are
+ * not requested. Build with -DTG_NO_STATS (make NOSTATS=1) to compile the
+ * counters out of the hot paths entirely.
+ */
+
+#include <stdio.h>
+
+enum { TG_FILL, TG_MASK, TG_SEARCH, TG_PHASES };
+
+struct tg_stats {
+  long calls;       // solver/search function calls
+  long nodes;       // placements tried or moves made
+  long backtracks;  // placements undone
+  long checks;      // constraint checks or leaf evaluations
+  long prunes;      // candidates rejected before recursing
+  long long ns[TG_PHASES], t0[TG_PHASES];  // wall time per phase
+};
+
+#ifdef TG_NO_STATS
+#define TG_COUNT(s, field) ((void)0)
+#else
+#define TG_COUNT(s, field) ((s) ? (void)(s)->field++ : (void)0)
+#endif
+
+// start/stop wall time of `phase`, no-op if `s` is NULL
+void tg_stats_start(struct tg_stats *s, int phase);
+void tg_stats_stop(struct tg_stats *s, int phase);
+// print non-zero counters and phase times
+void tg_stats_print(const struct tg_stats *s, FILE *f);
+
+#endif
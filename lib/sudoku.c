@@ -0,0 +1,63 @@
+#include <string.h>
+
+#include "tinygames.h"
+
+// Validate number `n` placement at [r, c] for grid `g` with width `w`
+static int valid(const int *g, int w, int r, int c, int n) {
+  int u = 2, v = 2;          // 2x2 blocks (4x4 Sudoku)
+  if (w == 9) u = v = 3;     // 3x3 blocks (9x9 Sudoku)
+  if (w == 6) u = 3, v = 2;  // 3x2 blocks (6x6 Sudoku)
+  for (int i = 0; i < w; i++)
+    if (g[r * w + i] == n || g[i * w + c] == n ||
+        g[(r / v * v + i / u) * w + (c / u * u + i % u)] == n)
+      return 0;
+  return 1;
+}
+
+int tg_sudoku_solve(struct tg_sudoku *s, int *g, int pos, int maxcnt) {
+  TG_COUNT(s->stats, calls);
+  if (pos == s->n) return 1;                                // Found a solution
+  if (g[pos]) return tg_sudoku_solve(s, g, pos + 1, maxcnt);  // Pre-filled
+
+  int w = s->w, r = pos / w, c = pos % w, solutions = 0;
+  int N[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  tg_shuffle(&s->rng, N, w);  // Randomise numbers for diversity
+
+  for (int i = 0; i < w; i++) {
+    TG_COUNT(s->stats, checks);
+    if (valid(g, w, r, c, N[i])) {
+      TG_COUNT(s->stats, nodes);
+      g[pos] = N[i];
+      solutions += tg_sudoku_solve(s, g, pos + 1, maxcnt);
+      if (solutions >= maxcnt) break;  // Stop early if maxcnt reached
+      TG_COUNT(s->stats, backtracks);
+      g[pos] = 0;  // Backtrack
+    }
+  }
+  return solutions;
+}
+
+int tg_sudoku_fill(struct tg_sudoku *s, int w) {
+  if (w != 4 && w != 6 && w != 9) return -1;
+  s->w = w, s->n = w * w;
+  memset(s->g, 0, sizeof(s->g));
+  tg_sudoku_solve(s, s->g, 0, 1);
+  memcpy(s->a, s->g, sizeof(s->a));
+  return 0;
+}
+
+void tg_sudoku_mask(struct tg_sudoku *s, int hide) {
+  int positions[81], tmp[81], n = s->n, *g = s->g;
+  for (int i = 0; i < n; i++) positions[i] = i;  // Index grid positions
+  tg_shuffle(&s->rng, positions, n);             // Randomise removal order
+
+  for (int attempts = 0; hide > 0 && attempts < n; attempts++) {
+    int pos = positions[attempts];
+    if (g[pos] == 0) continue;  // Skip already masked cells
+    int backup = g[pos];
+    g[pos] = 0;                       // Temporarily remove cell
+    memcpy(tmp, g, sizeof(int) * n);  // Create working copy
+    if (tg_sudoku_solve(s, tmp, 0, 2) != 1) g[pos] = backup;  // Not unique
+    else hide--, attempts = 0;
+  }
+}
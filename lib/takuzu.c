@@ -0,0 +1,88 @@
+#include <string.h>
+
+#include "tinygames.h"
+
+// Compare two sequences (rows/columns) for equality
+static int eq(const int *g, int a, int b, int step, int n) {
+  for (int i = 0; i < n; i++)
+    if (g[a + i * step] != g[b + i * step]) return 0;
+  return 1;
+}
+
+// Check if placing `v` at position [r, c] is valid, place it if so
+static int valid(int *g, int w, int r, int c, int v) {
+  // Check for no three consecutive values in row or column
+  if ((r >= 2 && g[(r - 2) * w + c] == v && g[(r - 1) * w + c] == v) ||
+      (c >= 2 && g[r * w + c - 2] == v && g[r * w + c - 1] == v))
+    return 0;
+  int nr = 0, nc = 0;
+  for (int i = 0; i < w; i++) nr += g[r * w + i] == v, nc += g[i * w + c] == v;
+  if (nr > w / 2 || nc > w / 2) return 0;
+
+  // Check for uniqueness in row and column
+  g[r * w + c] = v;
+  for (int i = 0; i < r; i++)
+    if (eq(g, i * w, r * w, 1, w)) return g[r * w + c] = -1, 0;
+  for (int i = 0; r == w - 1 && i < c; i++)
+    if (eq(g, i, c, w, w)) return g[r * w + c] = -1, 0;
+  return 1;
+}
+
+// Recursively solve or fill the grid, giving up when `budget` (if any) of
+// visited cells runs out
+static int solve(struct tg_takuzu *t, int *g, int pos, int maxcnt,
+                 long *budget) {
+  int n = t->n;
+  TG_COUNT(t->stats, calls);
+  if (budget && --*budget < 0) return 0;  // Out of budget
+  if (pos == n * n) return 1;             // Found a solution
+  if (g[pos] != -1) return solve(t, g, pos + 1, maxcnt, budget);
+
+  int solutions = 0, r = pos / n, c = pos % n, xor = tg_rand(&t->rng) & 1;
+  for (int i = 0; i < 2; i++) {
+    TG_COUNT(t->stats, checks);
+    if (valid(g, n, r, c, i ^ xor)) {
+      TG_COUNT(t->stats, nodes);
+      solutions += solve(t, g, pos + 1, maxcnt, budget);
+      if (solutions >= maxcnt) break;  // Stop early if maxcnt reached
+      TG_COUNT(t->stats, backtracks);
+      g[pos] = -1;  // Backtrack
+    }
+  }
+  return solutions;
+}
+
+int tg_takuzu_solve(struct tg_takuzu *t, int *g, int pos, int maxcnt) {
+  return solve(t, g, pos, maxcnt, NULL);
+}
+
+int tg_takuzu_fill(struct tg_takuzu *t, int n) {
+  if (n < 2 || n % 2 || n > TG_TAKUZU_MAX) return -1;
+  t->n = n;
+  // Random backtracking has a heavy tail on large grids: some orders take
+  // minutes. Restart with fresh random choices when a fill runs too long.
+  for (int found = 0; !found;) {
+    long budget = 20L * n * n;
+    memset(t->g, -1, sizeof(t->g));
+    found = solve(t, t->g, 0, 1, &budget);
+  }
+  memcpy(t->a, t->g, sizeof(t->a));
+  return 0;
+}
+
+void tg_takuzu_mask(struct tg_takuzu *t, int hide) {
+  int positions[TG_TAKUZU_MAX * TG_TAKUZU_MAX], tmp[TG_TAKUZU_MAX * TG_TAKUZU_MAX];
+  int n = t->n * t->n, *g = t->g;
+  for (int i = 0; i < n; i++) positions[i] = i;
+  tg_shuffle(&t->rng, positions, n);
+
+  for (int attempts = 0; hide > 0 && attempts < n; attempts++) {
+    int pos = positions[attempts];
+    if (g[pos] == -1) continue;  // Skip already masked cells
+    int backup = g[pos];
+    g[pos] = -1;                      // Temporarily mask cell
+    memcpy(tmp, g, sizeof(int) * n);  // Copy grid for testing
+    if (tg_takuzu_solve(t, tmp, 0, 2) != 1) g[pos] = backup;  // Not unique
+    else hide--, attempts = 0;  // Reset attempts on success
+  }
+}
@@ -0,0 +1,171 @@
+#ifndef TINYGAMES_H
+#define TINYGAMES_H
+
+/*
+ * libtinygames - reentrant game cores shared by the CLI programs and
+ * tinygamesd. All state lives in explicit context structs, so independent
+ * contexts can be used concurrently from different threads.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "stats.h"
+
+/* PCG32 random number generator with independent streams */
+
+struct tg_rng {
+  uint64_t state, inc;
+};
+
+// seed `r`; generators with different `stream` never share a sequence
+void tg_seed(struct tg_rng *r, uint64_t seed, uint64_t stream);
+uint32_t tg_rand(struct tg_rng *r);
+// unbiased random number in [0, n)
+uint32_t tg_below(struct tg_rng *r, uint32_t n);
+// Fisher-Yates shuffle of array `a` of `n` elements
+void tg_shuffle(struct tg_rng *r, int *a, int n);
+
+/* Sudoku: 4x4, 6x6 or 9x9 grid, 0 is an empty cell */
+
+struct tg_sudoku {
+  int w, n, g[81], a[81];  // width, cells, puzzle, answer
+  struct tg_rng rng;
+  struct tg_stats *stats;  // NULL unless --stats
+};
+
+// fill a random solved grid of width `w` into `g` and `a`, -1 if `w` invalid
+int tg_sudoku_fill(struct tg_sudoku *s, int w);
+// hide up to `hide` cells of `g`, keeping the solution unique
+void tg_sudoku_mask(struct tg_sudoku *s, int hide);
+// solve `g` starting at `pos`, return number of solutions up to `maxcnt`
+int tg_sudoku_solve(struct tg_sudoku *s, int *g, int pos, int maxcnt);
+
+/* Takuzu: even size up to 20, -1 is an empty cell */
+
+#define TG_TAKUZU_MAX 20
+
+struct tg_takuzu {
+  int n, g[TG_TAKUZU_MAX * TG_TAKUZU_MAX], a[TG_TAKUZU_MAX * TG_TAKUZU_MAX];
+  struct tg_rng rng;
+  struct tg_stats *stats;  // NULL unless --stats
+};
+
+// fill a random solved grid of size `n` into `g` and `a`, -1 if `n` invalid
+int tg_takuzu_fill(struct tg_takuzu *t, int n);
+// hide up to `hide` cells of `g`, keeping the solution unique
+void tg_takuzu_mask(struct tg_takuzu *t, int hide);
+// solve `g` starting at `pos`, return number of solutions up to `maxcnt`
+int tg_takuzu_solve(struct tg_takuzu *t, int *g, int pos, int maxcnt);
+
+/* Puzzle bank: pregenerated sudoku and takuzu puzzles in a packed file,
+ * see lib/bank.c for the format */
+
+enum { TG_BANK_SUDOKU, TG_BANK_TAKUZU };
+
+struct tg_bank_set {
+  uint32_t game, size, hide, count;  // size: width, hide: masked cells asked
+  uint64_t off;                      // file offset of the first record
+};
+
+struct tg_bank {
+  const uint8_t *p;  // read-only mapping of the whole file
+  size_t len;
+  int nsets;
+  const struct tg_bank_set *set;
+};
+
+// bytes per record of a `game` puzzle of `size`, 0 if invalid
+size_t tg_bank_recsize(int game, int size);
+// pack puzzle `g` and solution `a` into record `rec`
+void tg_bank_pack(int game, int size, const int *g, const int *a, uint8_t *rec);
+// set record offsets of `set`, return the file size; if `p` is not NULL, also
+// write the header and the set table there
+size_t tg_bank_layout(struct tg_bank_set *set, int nsets, uint8_t *p);
+// map the bank at `path` read-only and validate it, -1 on error
+int tg_bank_open(struct tg_bank *b, const char *path);
+void tg_bank_close(struct tg_bank *b);
+// set of `game` puzzles of `size` with `hide` masked cells, -1 if none
+int tg_bank_find(const struct tg_bank *b, int game, int size, int hide);
+// unpack puzzle `i` of `set` into `g` and `a`, return number of cells or -1
+int tg_bank_get(const struct tg_bank *b, int set, uint32_t i, int *g, int *a);
+
+/* Countdown: RPN expressions, numbers > 0 and operators -1..-4 for + - * / */
+
+#define TG_COUNTDOWN_MAX 10
+#define TG_COUNTDOWN_EXPR (3 * TG_COUNTDOWN_MAX)
+
+struct tg_countdown {
+  int n, nums[TG_COUNTDOWN_MAX], target;
+  int hint[TG_COUNTDOWN_EXPR], hlen;  // expression the target was built from
+  struct tg_rng rng;
+};
+
+// pick `n` numbers, 2..TG_COUNTDOWN_MAX (`big` of them from 25/50/75/100),
+// and a target in 101..998
+int tg_countdown_gen(struct tg_countdown *c, int n, int big);
+// evaluate expression `e` of `len` items, -1 if invalid
+int tg_countdown_calc(const int *e, int len);
+// find an expression closest to `target`, store it in `e` (`len` items) and
+// return the difference (0 for an exact solution), `stats` may be NULL
+int tg_countdown_solve(const int *nums, int n, int target, int *e, int *len,
+                       struct tg_stats *stats);
+
+/* Wordle */
+
+#define TG_WORD_LEN 64
+
+struct tg_dict {
+  char (*w)[TG_WORD_LEN];
+  int n;
+};
+
+// load lowercase words from `path`, return number of words or -1
+int tg_dict_load(struct tg_dict *d, const char *path);
+// random word of length `len`, NULL if there is none
+const char *tg_wordle_pick(const struct tg_dict *d, int len, struct tg_rng *r);
+// write "#+." hints for `guess` into `out`, return 1 if guessed right
+int tg_wordle_score(const char *guess, const char *secret, char *out);
+
+/* Bulls and cows */
+
+// generate a secret of 4 different digits
+void tg_bullscows_gen(char secret[5], struct tg_rng *r);
+// count bulls and cows of `guess`, return 1 if guessed right
+int tg_bullscows_score(const char *secret, const char *guess, int *bulls,
+                       int *cows);
+
+/* Dobble: N=6 (31 cards) or N=8 (57 cards) symbols per card */
+
+struct tg_dobble {
+  int n, sz, deck[57];    // symbols per card, cards, shuffled card order
+  const char *c[57 * 8];  // card symbols
+  struct tg_rng rng;
+};
+
+// generate and shuffle a deck of cards with `n` symbols, -1 if `n` invalid
+int tg_dobble_init(struct tg_dobble *d, int n);
+// return a symbol, common between i-th and j-th cards
+const char *tg_dobble_match(const struct tg_dobble *d, int i, int j);
+
+/* MiniChess: 4x5, 5x5 or 6x6, see lib/chess.c for the board layout */
+
+struct tg_chess {
+  int w, h, e, b[48];      // width, height, end square, board
+  int m[1024], *sp;        // move stack for negamax
+  struct tg_stats *stats;  // NULL unless --stats
+};
+
+extern const char *tg_chess_pieces;
+// set up the initial position for `mode` 4, 5 or 6, -1 if invalid
+int tg_chess_init(struct tg_chess *c, int mode);
+// rotate the board and swap sides
+void tg_chess_flip(struct tg_chess *c);
+// push all valid moves of the player to the move stack
+void tg_chess_moves(struct tg_chess *c);
+int tg_chess_eval(const struct tg_chess *c);
+// apply move, return captured piece
+int tg_chess_move(struct tg_chess *c, int m);
+int tg_chess_negamax(struct tg_chess *c, int depth, int *best);
+
+#endif
@@ -0,0 +1,38 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tinygames.h"
+
+int tg_dict_load(struct tg_dict *d, const char *path) {
+  char x[TG_WORD_LEN];
+  FILE *f = fopen(path, "r");
+  if (!f) return -1;
+  d->w = NULL, d->n = 0;
+  while (fgets(x, TG_WORD_LEN, f)) {
+    int l = strlen(x);
+    if (l && x[l - 1] == '\n') x[--l] = 0;
+    if (!l || !islower(*x)) continue;
+    if ((d->n & (d->n - 1)) == 0)  // grow at powers of two
+      d->w = realloc(d->w, sizeof(*d->w) * (d->n ? d->n * 2 : 1));
+    strcpy(d->w[d->n++], x);
+  }
+  fclose(f);
+  return d->n;
+}
+
+const char *tg_wordle_pick(const struct tg_dict *d, int len, struct tg_rng *r) {
+  const char *g = NULL;
+  for (int i = 0, n = 0; i < d->n; i++)
+    if ((int)strlen(d->w[i]) == len && tg_below(r, ++n) == 0) g = d->w[i];
+  return g;
+}
+
+int tg_wordle_score(const char *guess, const char *secret, char *out) {
+  int i = 0;
+  for (; guess[i]; i++)
+    out[i] = guess[i] == secret[i] ? '#' : strchr(secret, guess[i]) ? '+' : '.';
+  out[i] = 0;
+  return !strcmp(guess, secret);
+}
@@ -0,0 +1,391 @@
+#define _GNU_SOURCE
+#include "games.h"
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+void bput(struct buf *b, const char *s, size_t n) {
+  if (b->len + n + 1 > b->cap) {
+    while (b->len + n + 1 > b->cap) b->cap = b->cap ? b->cap * 2 : 256;
+    b->p = realloc(b->p, b->cap);
+  }
+  memcpy(b->p + b->len, s, n);
+  b->len += n;
+  b->p[b->len] = 0;
+}
+
+void bprintf(struct buf *b, const char *fmt, ...) {
+  char tmp[512];
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(tmp, sizeof(tmp), fmt, ap);
+  va_end(ap);
+  if (n > 0) bput(b, tmp, n < (int)sizeof(tmp) ? (size_t)n : sizeof(tmp) - 1);
+}
+
+// value of option `f` (e.g. "-m") in argv, or `def` if missing
+static int opt(int argc, char **argv, const char *f, int def) {
+  for (int i = 1; i + 1 < argc; i++)
+    if (!strcmp(argv[i], f)) return atoi(argv[i + 1]);
+  return def;
+}
+
+// 1 if flag `f` is present in argv
+static int flag(int argc, char **argv, const char *f) {
+  for (int i = 1; i < argc; i++)
+    if (!strcmp(argv[i], f)) return 1;
+  return 0;
+}
+
+// seed `r` from the -s option (reproducible), otherwise from the clock, with
+// the session state address as stream so concurrent sessions never collide
+static void seed(struct tg_rng *r, int argc, char **argv) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  if (flag(argc, argv, "-s")) tg_seed(r, opt(argc, argv, "-s", 0), 0);
+  else tg_seed(r, ts.tv_sec * 1000000000ULL + ts.tv_nsec, (uintptr_t)r);
+}
+
+static long long now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+}
+
+// concatenate argv[0..argc) into `s` dropping whitespace, return length
+static int join(int argc, char **argv, char *s, int max) {
+  int n = 0;
+  for (int i = 0; i < argc; i++)
+    for (char *p = argv[i]; *p && n < max; p++) s[n++] = *p;
+  return n;
+}
+
+// print grid `g` of `n` cells and `w` columns, `blank` is an empty cell
+static void grid(struct buf *out, const int *g, int n, int w, int blank) {
+  for (int i = 0; i < n; i++)
+    bprintf(out, "%c%c", g[i] == blank ? '.' : g[i] + '0',
+            (i + 1) % w ? ' ' : '\n');
+}
+
+// compare `argc` tokens of digits against answer `a` of `n` cells
+static int check(int argc, char **argv, const int *a, int n, struct buf *out) {
+  char g[TG_TAKUZU_MAX * TG_TAKUZU_MAX];
+  if (join(argc, argv, g, sizeof(g)) != n)
+    return bprintf(out, "Must be %d digits.\n", n), GAME_ERR;
+  for (int i = 0; i < n; i++)
+    if (g[i] - '0' != a[i]) return bprintf(out, "Incorrect.\n"), GAME_OK;
+  return bprintf(out, "Correct!\n"), GAME_END;
+}
+
+/* Puzzle bank */
+
+static struct tg_bank bank;
+
+int bank_load(const char *path) { return tg_bank_open(&bank, path); }
+
+// copy a banked puzzle (the -i option, or a random one) into `g` and `a`,
+// return 0 if the bank has no such set, -1 if the index is out of range
+static int banked(int game, int size, int hide, struct tg_rng *r, int argc,
+                  char **argv, int *g, int *a) {
+  int k = bank.p ? tg_bank_find(&bank, game, size, hide) : -1;
+  if (k < 0) return 0;
+  int i = opt(argc, argv, "-i", -1);
+  if (i < 0) i = tg_below(r, bank.set[k].count);
+  return tg_bank_get(&bank, k, i, g, a);
+}
+
+/* Sudoku */
+
+static int sudoku_start(union game_state *st, int argc, char **argv,
+                        struct buf *out) {
+  struct tg_sudoku *s = &st->sudoku;
+  int w = flag(argc, argv, "-4") ? 4 : flag(argc, argv, "-6") ? 6 : 9;
+  int hide = opt(argc, argv, "-m", 40);
+  s->stats = NULL;
+  seed(&s->rng, argc, argv);
+  switch (banked(TG_BANK_SUDOKU, w, hide, &s->rng, argc, argv, s->g, s->a)) {
+    case -1: return bprintf(out, "no such puzzle\n"), GAME_ERR;
+    case 0: tg_sudoku_fill(s, w), tg_sudoku_mask(s, hide); break;
+    default: s->w = w, s->n = w * w;
+  }
+  grid(out, s->g, s->n, s->w, 0);
+  return GAME_OK;
+}
+
+static int sudoku_play(union game_state *st, int argc, char **argv,
+                       struct buf *out) {
+  struct tg_sudoku *s = &st->sudoku;
+  if (!strcmp(argv[0], "answer")) return grid(out, s->a, s->n, s->w, 0), GAME_END;
+  return check(argc, argv, s->a, s->n, out);
+}
+
+/* Takuzu */
+
+static int takuzu_start(union game_state *st, int argc, char **argv,
+                        struct buf *out) {
+  struct tg_takuzu *t = &st->takuzu;
+  int n = opt(argc, argv, "-n", 8), hide = opt(argc, argv, "-m", 20);
+  t->stats = NULL;
+  seed(&t->rng, argc, argv);
+  switch (banked(TG_BANK_TAKUZU, n, hide, &t->rng, argc, argv, t->g, t->a)) {
+    case -1: return bprintf(out, "no such puzzle\n"), GAME_ERR;
+    case 0:
+      if (tg_takuzu_fill(t, n) < 0)
+        return bprintf(out, "size must be even and <= %d\n", TG_TAKUZU_MAX),
+               GAME_ERR;
+      tg_takuzu_mask(t, hide);
+      break;
+    default: t->n = n;
+  }
+  grid(out, t->g, t->n * t->n, t->n, -1);
+  return GAME_OK;
+}
+
+static int takuzu_play(union game_state *st, int argc, char **argv,
+                       struct buf *out) {
+  struct tg_takuzu *t = &st->takuzu;
+  if (!strcmp(argv[0], "answer"))
+    return grid(out, t->a, t->n * t->n, t->n, -1), GAME_END;
+  return check(argc, argv, t->a, t->n * t->n, out);
+}
+
+/* Countdown */
+
+static void expr(struct buf *out, const int *e, int n) {
+  for (int i = 0; i < n; i++)
+    if (e[i] > 0) bprintf(out, "%d ", e[i]);
+    else bprintf(out, "%c ", "+-*/"[-e[i] - 1]);
+  bprintf(out, "\n");
+}
+
+static int countdown_start(union game_state *st, int argc, char **argv,
+                           struct buf *out) {
+  struct tg_countdown *c = &st->countdown;
+  seed(&c->rng, argc, argv);
+  if (tg_countdown_gen(c, opt(argc, argv, "-n", 6), opt(argc, argv, "-b", 2)) < 0)
+    return bprintf(out, "can't generate numbers with these options\n"), GAME_ERR;
+  for (int i = 0; i < c->n; i++) bprintf(out, "%d ", c->nums[i]);
+  bprintf(out, "=> %d\n", c->target);
+  return GAME_OK;
+}
+
+static int countdown_play(union game_state *st, int argc, char **argv,
+                          struct buf *out) {
+  struct tg_countdown *c = &st->countdown;
+  int e[TG_COUNTDOWN_EXPR], n = 0, used[TG_COUNTDOWN_MAX] = {0};
+  if (!strcmp(argv[0], "solve")) {
+    int diff = tg_countdown_solve(c->nums, c->n, c->target, e, &n, NULL);
+    if (diff) bprintf(out, "Closest solution (off by %d): ", diff);
+    else bprintf(out, "Exact solution: ");
+    expr(out, e, n);
+    return GAME_END;
+  }
+  // RPN expression using each of the given numbers at most once
+  for (int i = 0; i < argc && n < TG_COUNTDOWN_EXPR; i++) {
+    char *op = strchr("+-*/", argv[i][0]);
+    if (op && !argv[i][1]) {
+      e[n++] = -(op - "+-*/" + 1);
+      continue;
+    }
+    int v = atoi(argv[i]), k = 0;
+    while (k < c->n && (used[k] || c->nums[k] != v)) k++;
+    if (k == c->n) return bprintf(out, "%s is not available\n", argv[i]), GAME_ERR;
+    used[k] = 1, e[n++] = v;
+  }
+  int r = tg_countdown_calc(e, n);
+  if (r < 0) return bprintf(out, "invalid expression\n"), GAME_ERR;
+  if (r == c->target) return bprintf(out, "Correct! %d\n", r), GAME_END;
+  bprintf(out, "%d (off by %d)\n", r, abs(r - c->target));
+  return GAME_OK;
+}
+
+/* Wordle */
+
+static struct tg_dict dict;
+
+int wordle_load(const char *path) { return tg_dict_load(&dict, path); }
+
+static int wordle_start(union game_state *st, int argc, char **argv,
+                        struct buf *out) {
+  struct wordle *w = &st->wordle;
+  int len = opt(argc, argv, "-w", 5);
+  w->tries = opt(argc, argv, "-t", 6);
+  seed(&w->rng, argc, argv);
+  if (!(w->secret = tg_wordle_pick(&dict, len, &w->rng)))
+    return bprintf(out, "No words of length %d\n", len), GAME_ERR;
+  bprintf(out, "Guess the %d-letter word!\n%d tries left\n", len, w->tries);
+  return GAME_OK;
+}
+
+static int wordle_play(union game_state *st, int argc, char **argv,
+                       struct buf *out) {
+  struct wordle *w = &st->wordle;
+  char *x = argv[0], h[TG_WORD_LEN];
+  (void)argc;
+  if (strlen(x) != strlen(w->secret))
+    return bprintf(out, "Must be %d letters.\n", (int)strlen(w->secret)), GAME_ERR;
+  for (char *p = x; *p; p++) *p = tolower(*p);
+  if (tg_wordle_score(x, w->secret, h))
+    return bprintf(out, "Correct! The word was %s.\n", w->secret), GAME_END;
+  if (--w->tries == 0)
+    return bprintf(out, "%s\nOut of tries! The word was %s.\n", h, w->secret), GAME_END;
+  bprintf(out, "%s\n%d tries left\n", h, w->tries);
+  return GAME_OK;
+}
+
+/* Bulls and cows */
+
+static int bullscows_start(union game_state *st, int argc, char **argv,
+                           struct buf *out) {
+  struct bullscows *g = &st->bullscows;
+  seed(&g->rng, argc, argv);
+  tg_bullscows_gen(g->secret, &g->rng);
+  g->tries = 0;
+  bprintf(out, "Guess 4 different digits\n");
+  return GAME_OK;
+}
+
+static int bullscows_play(union game_state *st, int argc, char **argv,
+                          struct buf *out) {
+  struct bullscows *g = &st->bullscows;
+  int b, c;
+  (void)argc;
+  if (strlen(argv[0]) != 4) return bprintf(out, "Must be 4 digits.\n"), GAME_ERR;
+  g->tries++;
+  if (tg_bullscows_score(g->secret, argv[0], &b, &c))
+    return bprintf(out, "You win in %d tries!\n", g->tries), GAME_END;
+  bprintf(out, "%d bulls, %d cows\n", b, c);
+  return GAME_OK;
+}
+
+/* Dobble */
+
+static void card(struct buf *out, struct tg_dobble *d, const char *prefix, int i) {
+  bprintf(out, "%s", prefix);
+  for (int j = 0; j < d->n; j++) bprintf(out, "%s ", d->c[i * d->n + j]);
+  bprintf(out, "\n");
+}
+
+static void deal(struct buf *out, struct dobble *g) {
+  card(out, &g->d, "Top: ", g->d.deck[g->top]);
+  card(out, &g->d, "You: ", g->d.deck[g->i]);
+  g->t0 = now();
+}
+
+static int cmp(const void *a, const void *b) { return *(int *)a - *(int *)b; }
+
+static int dobble_start(union game_state *st, int argc, char **argv,
+                        struct buf *out) {
+  struct dobble *g = &st->dobble;
+  seed(&g->d.rng, argc, argv);
+  if (tg_dobble_init(&g->d, opt(argc, argv, "-n", 6)) < 0)
+    return bprintf(out, "-n must be 6 or 8\n"), GAME_ERR;
+  g->top = 0, g->i = 1, g->won = 0, g->nrt = 0;
+  deal(out, g);
+  return GAME_OK;
+}
+
+static int dobble_play(union game_state *st, int argc, char **argv,
+                       struct buf *out) {
+  struct dobble *g = &st->dobble;
+  struct tg_dobble *d = &g->d;
+  int sym = atoi(argv[0]), card = d->deck[g->i], sz = d->sz;
+  (void)argc;
+  if (sym < 1 || sym > d->n) return bprintf(out, "Symbol (1-%d)?\n", d->n), GAME_ERR;
+  const char *answer = tg_dobble_match(d, card, d->deck[g->top]);
+  g->rt[g->nrt++] = now() - g->t0;
+  if (!strcmp(answer, d->c[d->n * card + sym - 1])) {
+    bprintf(out, "Correct %s!\n", answer);
+    g->top = g->i++, g->won++;
+  } else {
+    bprintf(out, "Incorrect, it was %s\n", answer);
+    g->top = g->i + 1, g->i += 2;
+  }
+  if (g->i < sz) return deal(out, g), GAME_OK;
+  bprintf(out, "You %s: %d vs %d\n", g->won >= (sz - 1) / 2 ? "won" : "lost",
+          g->won, sz - g->won - 1);
+  qsort(g->rt, g->nrt, sizeof(int), cmp);
+  bprintf(out, "Reaction (ms): min %d, p50 %d, p90 %d, p99 %d, max %d\n",
+          g->rt[0], g->rt[g->nrt * 50 / 100], g->rt[g->nrt * 90 / 100],
+          g->rt[g->nrt * 99 / 100], g->rt[g->nrt - 1]);
+  return GAME_END;
+}
+
+/* MiniChess */
+
+static void board(struct buf *out, struct tg_chess *c) {
+  for (int i = 0; i < c->w * c->h; i++)
+    bprintf(out, "%c%c", tg_chess_pieces[c->b[i / c->w * 8 + i % c->w] + 6],
+            (i + 1) % c->w ? ' ' : '\n');
+}
+
+// print square `sq` in algebraic notation, `flip` for the opponent's side
+static void square(struct buf *out, struct tg_chess *c, int sq, int flip) {
+  if (flip) sq = c->e - 1 - sq;
+  bprintf(out, "%c%d", 'a' + sq % 8, c->h - sq / 8);
+}
+
+static int chess_start(union game_state *st, int argc, char **argv,
+                       struct buf *out) {
+  struct tg_chess *c = &st->chess;
+  int mode = opt(argc, argv, "-n", 6);
+  c->stats = NULL;
+  if (tg_chess_init(c, mode) < 0) return bprintf(out, "invalid mode: %d\n", mode), GAME_ERR;
+  board(out, c);
+  return GAME_OK;
+}
+
+static int chess_play(union game_state *st, int argc, char **argv,
+                      struct buf *out) {
+  struct tg_chess *c = &st->chess;
+  char c1, c2;
+  int r1, r2, n, *u, best = 0;
+  (void)argc;
+  c->sp = c->m;
+  tg_chess_moves(c);
+  if (!strcmp(argv[0], "moves")) {
+    for (u = c->m; u < c->sp; u++)
+      square(out, c, *u >> 8, 0), square(out, c, *u & 0xff, 0), bput(out, " ", 1);
+    return bprintf(out, "\n"), GAME_OK;
+  }
+  if (sscanf(argv[0], "%c%d%c%d", &c1, &r1, &c2, &r2) != 4)
+    return bprintf(out, "invalid move\n"), GAME_ERR;
+  n = ((8 * (c->h - r1) + c1 - 'a') << 8) | (8 * (c->h - r2) + c2 - 'a');
+  for (u = c->m; u < c->sp; u++)
+    if (*u == n) break;
+  if (u == c->sp) return bprintf(out, "invalid move\n"), GAME_ERR;
+  tg_chess_move(c, n);
+  tg_chess_flip(c);
+  tg_chess_negamax(c, 2, &best);
+  if (best == 0 || tg_chess_eval(c) < -100 || tg_chess_eval(c) > 100)
+    return bprintf(out, "GAME OVER: %d\n", tg_chess_eval(c)), GAME_END;
+  tg_chess_move(c, best);
+  tg_chess_flip(c);
+  bprintf(out, "opponent: ");
+  square(out, c, best >> 8, 1), square(out, c, best & 0xff, 1);
+  bprintf(out, " (eval %d)\n", tg_chess_eval(c));
+  board(out, c);
+  return GAME_OK;
+}
+
+const struct game games[] = {
+    {"sudoku", 1, sudoku_start, sudoku_play},
+    {"takuzu", 1, takuzu_start, takuzu_play},
+    {"countdown", 1, countdown_start, countdown_play},
+    {"wordle", 0, wordle_start, wordle_play},
+    {"bullscows", 0, bullscows_start, bullscows_play},
+    {"dobble", 0, dobble_start, dobble_play},
+    {"chess", 1, chess_start, chess_play},
+    {NULL, 0, NULL, NULL},
+};
+
+const struct game *find_game(const char *name) {
+  for (const struct game *g = games; g->name; g++)
+    if (!strcmp(g->name, name)) return g;
+  return NULL;
+}
@@ -0,0 +1,67 @@
+#ifndef GAMES_H
+#define GAMES_H
+
+// Session adapters of libtinygames for tinygamesd. Every game keeps its
+// state in a per-session struct (no globals), so sessions can run on any
+// thread.
+
+#include <stddef.h>
+
+#include "tinygames.h"
+
+// growable output buffer
+struct buf {
+  char *p;
+  size_t len, cap;
+};
+void bput(struct buf *b, const char *s, size_t n);
+void bprintf(struct buf *b, const char *fmt, ...);
+
+struct wordle {
+  int tries;
+  const char *secret;
+  struct tg_rng rng;
+};
+
+struct bullscows {
+  char secret[5];
+  int tries;
+  struct tg_rng rng;
+};
+
+struct dobble {
+  struct tg_dobble d;
+  int top, i, won, nrt, rt[57];  // rt: reaction times, ms
+  long long t0;                  // time the card was dealt
+};
+
+union game_state {
+  struct tg_sudoku sudoku;
+  struct tg_takuzu takuzu;
+  struct tg_countdown countdown;
+  struct wordle wordle;
+  struct bullscows bullscows;
+  struct dobble dobble;
+  struct tg_chess chess;
+};
+
+// return codes of start/play
+enum { GAME_ERR = -1, GAME_OK = 0, GAME_END = 1 };
+
+struct game {
+  const char *name;
+  int heavy;  // CPU-heavy: commands run on the worker pool
+  int (*start)(union game_state *st, int argc, char **argv, struct buf *out);
+  int (*play)(union game_state *st, int argc, char **argv, struct buf *out);
+};
+
+extern const struct game games[];
+const struct game *find_game(const char *name);
+
+// load wordle dictionary (shared, read-only after loading)
+int wordle_load(const char *path);
+// map a puzzle bank built by tgbank, sudoku and takuzu sets found there are
+// served from it instead of being generated
+int bank_load(const char *path);
+
+#endif
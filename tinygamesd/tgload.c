@@ -0,0 +1,180 @@
+/*
+ * Load generator for tinygamesd
+ *
+ * Plays scripted sessions of every game (or just one) over `c` concurrent
+ * connections and reports sessions/sec and latency percentiles, separately
+ * for game starts (which include puzzle generation) and moves.
+ *
+ * Command-line options:
+ * -p <path>    Socket path (default: /tmp/tinygamesd.sock)
+ * -c <conns>   Concurrent connections (default: 16)
+ * -n <count>   Total sessions to play (default: 1000)
+ * -g <game>    Only play this game (default: all games in turn)
+ */
+#define _GNU_SOURCE
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+static const char *all[] = {"sudoku", "takuzu",    "countdown", "wordle",
+                            "bullscows", "dobble", "chess",     NULL};
+static const char *only;
+static struct sockaddr_un addr = {.sun_family = AF_UNIX};
+static int total = 1000, next, errors;
+static pthread_mutex_t mu = PTHREAD_MUTEX_INITIALIZER;
+
+// latency histograms of game starts and of moves
+enum { START, MOVE };
+
+struct lat {
+  long *us, n, cap;
+};
+
+struct conn {
+  int fd, len;
+  char buf[1 << 14];  // last reply
+  struct lat lat[2];  // request latencies by kind
+};
+
+static long long now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+// status of a complete reply in c->buf: 'o'k, 'e'nd, e'r'r, or 0 if partial
+static int status(struct conn *c) {
+  if (c->len < 3 || c->buf[c->len - 1] != '\n') return 0;
+  char *last = c->buf + c->len - 2;
+  while (last > c->buf && last[-1] != '\n') last--;
+  if (!strcmp(last, "ok\n")) return 'o';
+  if (!strcmp(last, "end\n")) return 'e';
+  if (!strcmp(last, "err\n")) return 'r';
+  return 0;
+}
+
+// send a command of `kind` and wait for the reply, return its status (-1 on
+// I/O error)
+static int req(struct conn *c, int kind, const char *fmt, const char *arg) {
+  char line[256];
+  int n = snprintf(line, sizeof(line), fmt, arg), st = 0;
+  long long t0 = now_us();
+  if (write(c->fd, line, n) != n) return -1;
+  for (c->len = 0; !(st = status(c));) {
+    ssize_t r = read(c->fd, c->buf + c->len, sizeof(c->buf) - 1 - c->len);
+    if (r <= 0) return -1;
+    c->buf[c->len += r] = 0;
+  }
+  struct lat *l = &c->lat[kind];
+  if (l->n == l->cap)
+    l->us = realloc(l->us, sizeof(long) * (l->cap = l->cap ? l->cap * 2 : 1024));
+  l->us[l->n++] = now_us() - t0;
+  return st;
+}
+
+// play one scripted session of `game`
+static int play(struct conn *c, const char *game, int id) {
+  static const char *words[] = {"crane", "slate", "pious", "dumpy", "forth",
+                                "begin", NULL};
+  static const char *codes[] = {"0123", "4567", "8901", "2345", "6789", NULL};
+  char start[64], mv[8];
+  int st;
+  if (!strcmp(game, "chess")) snprintf(start, sizeof(start), "chess -n 6");
+  else if (!strcmp(game, "sudoku")) snprintf(start, sizeof(start), "sudoku -m 40 -s %d", id);
+  else if (!strcmp(game, "takuzu")) snprintf(start, sizeof(start), "takuzu -n 8 -m 20 -s %d", id);
+  else snprintf(start, sizeof(start), "%s -s %d", game, id);
+  if ((st = req(c, START, "%s\n", start)) != 'o') return st;
+
+  if (!strcmp(game, "sudoku") || !strcmp(game, "takuzu")) return req(c, MOVE, "answer\n", NULL);
+  if (!strcmp(game, "countdown")) return req(c, MOVE, "solve\n", NULL);
+  for (int i = 0; i < 5 && st == 'o'; i++) {
+    if (!strcmp(game, "wordle")) st = req(c, MOVE, "%s\n", words[i]);
+    else if (!strcmp(game, "bullscows")) st = req(c, MOVE, "%s\n", codes[i]);
+    else if (!strcmp(game, "dobble")) st = req(c, MOVE, "1\n", NULL);
+    else if ((st = req(c, MOVE, "moves\n", NULL)) == 'o' && sscanf(c->buf, "%4s", mv) == 1)
+      st = req(c, MOVE, "%s\n", mv);
+  }
+  return st == 'o' ? req(c, MOVE, "quit\n", NULL) : st;
+}
+
+static void *run(void *arg) {
+  struct conn *c = arg;
+  for (;;) {
+    pthread_mutex_lock(&mu);
+    int id = next < total ? next++ : -1;
+    pthread_mutex_unlock(&mu);
+    if (id < 0) break;
+    c->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    int st = connect(c->fd, (struct sockaddr *)&addr, sizeof(addr));
+    if (st == 0) st = play(c, only ? only : all[id % 7], id);
+    if (st != 'e') {
+      pthread_mutex_lock(&mu);
+      errors++;
+      pthread_mutex_unlock(&mu);
+    }
+    close(c->fd);
+  }
+  return NULL;
+}
+
+static int cmp(const void *a, const void *b) {
+  return (*(long *)a > *(long *)b) - (*(long *)a < *(long *)b);
+}
+
+// merge latencies of `kind` from all connections and print percentiles
+static long report(const char *name, struct conn *conns, int nconns, int kind) {
+  long n = 0, *us = NULL;
+  for (int i = 0; i < nconns; i++) {
+    struct lat *l = &conns[i].lat[kind];
+    us = realloc(us, sizeof(long) * (n + l->n));
+    memcpy(us + n, l->us, sizeof(long) * l->n);
+    n += l->n;
+  }
+  if (n) {
+    qsort(us, n, sizeof(long), cmp);
+    printf("%s: %ld, latency (us): p50 %ld, p90 %ld, p99 %ld, max %ld\n", name,
+           n, us[n * 50 / 100], us[n * 90 / 100], us[n * 99 / 100], us[n - 1]);
+  }
+  free(us);
+  return n;
+}
+
+int main(int argc, char *argv[]) {
+  int opt, nconns = 16;
+  char *path = "/tmp/tinygamesd.sock";
+  while ((opt = getopt(argc, argv, "p:c:n:g:")) != -1) {
+    switch (opt) {
+      case 'p': path = optarg; break;          // Socket path
+      case 'c': nconns = atoi(optarg); break;  // Concurrent connections
+      case 'n': total = atoi(optarg); break;   // Sessions to play
+      case 'g': only = optarg; break;          // Single game
+      default:
+        fprintf(stderr,
+                "USAGE: %s [-p <path>] [-c <conns>] [-n <sessions>] [-g <game>]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (nconns < 1 || strlen(path) >= sizeof(addr.sun_path))
+    return fprintf(stderr, "invalid options\n"), 1;
+  strcpy(addr.sun_path, path);
+
+  struct conn *conns = calloc(nconns, sizeof(*conns));
+  pthread_t *threads = calloc(nconns, sizeof(*threads));
+  long long t0 = now_us();
+  for (int i = 0; i < nconns; i++) pthread_create(&threads[i], NULL, run, &conns[i]);
+  for (int i = 0; i < nconns; i++) pthread_join(threads[i], NULL);
+  double secs = (now_us() - t0) / 1e6;
+
+  printf("sessions: %d in %.2fs (%.0f sessions/sec), errors: %d\n", total, secs,
+         total / secs, errors);
+  if (!report("starts", conns, nconns, START)) return 1;
+  report("moves", conns, nconns, MOVE);
+  return errors != 0;
+}
@@ -0,0 +1,309 @@
+/*
+ * Tiny Games Server
+ *
+ * Serves many concurrent sessions of any game over a local Unix domain socket
+ * from a single process. Connections are multiplexed with epoll, CPU-heavy
+ * commands (sudoku/takuzu generation, countdown solving, chess search) run on
+ * a worker pool. Each session keeps its own game state.
+ *
+ * Protocol is line based. A game name starts a new game with CLI-like options
+ * (e.g. "sudoku -6 -m 20 -s 42", "chess -n 5"), any other line is a move for
+ * the current game ("quit" ends it). Every reply ends with a status line: "ok"
+ * (waiting for the next move), "end" (game over) or "err".
+ *
+ * Command-line options:
+ * -p <path>    Socket path (default: /tmp/tinygamesd.sock)
+ * -j <n>       Worker threads (default: number of CPUs)
+ * -d <file>    Wordle dictionary (default: ../wordle/WORDS.txt)
+ * -b <file>    Puzzle bank (see bank/tgbank.c) to serve sudoku and takuzu from
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "games.h"
+
+#define MAX_LINE 4096
+#define MAX_INPUT (16 * MAX_LINE)   // input queued but not yet run
+#define MAX_OUTPUT (16 * MAX_LINE)  // replies queued for a slow reader
+#define MAX_ARGS 64
+
+struct session {
+  int fd, busy, dead;  // busy: a command is running on a worker
+  int closing;         // client is done sending, drop once it's answered
+  uint32_t events;     // epoll events being watched
+  const struct game *game;      // current game, NULL if none
+  union game_state st;
+  struct buf in, out;    // unprocessed input, unsent output
+  char *line;            // command handed to a worker
+  struct buf reply;      // worker output for that command
+  struct session *next;  // job/done queue link
+};
+
+// job queue (FIFO) and completed jobs (LIFO), both guarded by `mu`
+static struct session *jobs, **jobs_tail = &jobs, *done;
+// closed sessions, freed after the current batch of events
+static struct session *graveyard;
+static pthread_mutex_t mu = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cv = PTHREAD_COND_INITIALIZER;
+static int ep, lfd, efd;
+
+// run one command line for session `s`, append reply and status to `out`
+static void handle(struct session *s, char *line, struct buf *out) {
+  char *argv[MAX_ARGS], *save;
+  int argc = 0, r;
+  for (char *p = strtok_r(line, " \t\r", &save); p && argc < MAX_ARGS;
+       p = strtok_r(NULL, " \t\r", &save))
+    argv[argc++] = p;
+  const struct game *g = argc ? find_game(argv[0]) : NULL;
+  if (!argc) {
+    r = s->game ? GAME_OK : GAME_END;
+  } else if (g) {
+    s->game = g;
+    r = g->start(&s->st, argc, argv, out);
+    if (r == GAME_ERR) s->game = NULL;
+  } else if (!s->game) {
+    bprintf(out, "unknown game: %s, try:", argv[0]);
+    for (g = games; g->name; g++) bprintf(out, " %s", g->name);
+    bprintf(out, "\n");
+    r = GAME_ERR;
+  } else if (!strcmp(argv[0], "quit")) {
+    r = GAME_END;
+  } else {
+    r = s->game->play(&s->st, argc, argv, out);
+  }
+  if (r == GAME_END) s->game = NULL;
+  bprintf(out, r == GAME_ERR ? "err\n" : r == GAME_END ? "end\n" : "ok\n");
+}
+
+// does the command need the worker pool?
+static int heavy(struct session *s, const char *line) {
+  char cmd[32] = "";
+  sscanf(line, "%31s", cmd);
+  const struct game *g = find_game(cmd);
+  if (!g) g = s->game;
+  return g && g->heavy;
+}
+
+static void *worker(void *arg) {
+  (void)arg;
+  for (;;) {
+    pthread_mutex_lock(&mu);
+    while (!jobs) pthread_cond_wait(&cv, &mu);
+    struct session *s = jobs;
+    if (!(jobs = s->next)) jobs_tail = &jobs;
+    pthread_mutex_unlock(&mu);
+
+    handle(s, s->line, &s->reply);
+
+    pthread_mutex_lock(&mu);
+    s->next = done, done = s;
+    pthread_mutex_unlock(&mu);
+    uint64_t one = 1;
+    if (write(efd, &one, sizeof(one)) < 0) perror("eventfd");
+  }
+  return NULL;
+}
+
+static void submit(struct session *s) {
+  pthread_mutex_lock(&mu);
+  s->next = NULL, *jobs_tail = s, jobs_tail = &s->next;
+  pthread_cond_signal(&cv);
+  pthread_mutex_unlock(&mu);
+}
+
+static void bury(struct session *s) { s->next = graveyard, graveyard = s; }
+
+static void drop(struct session *s) {
+  if (s->dead) return;
+  epoll_ctl(ep, EPOLL_CTL_DEL, s->fd, NULL);
+  close(s->fd);
+  s->dead = 1;
+  if (!s->busy) bury(s);  // otherwise buried when the worker is done with it
+}
+
+// watch for input unless the client is done sending or too much input or
+// output is queued, and for output while some is pending
+static void watch(struct session *s) {
+  int full = s->in.len >= MAX_INPUT || s->out.len >= MAX_OUTPUT;
+  uint32_t events =
+      (s->closing || full ? 0 : EPOLLIN) | (s->out.len ? EPOLLOUT : 0);
+  if (events != s->events) {
+    struct epoll_event ev = {events, {.ptr = s}};
+    epoll_ctl(ep, EPOLL_CTL_MOD, s->fd, &ev);
+    s->events = events;
+  }
+}
+
+// send pending output, wait for EPOLLOUT if the socket is full; return -1 if
+// the session should be dropped (send error, or closing and fully answered)
+static int flush(struct session *s) {
+  size_t off = 0;
+  while (off < s->out.len) {
+    ssize_t n = send(s->fd, s->out.p + off, s->out.len - off, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0 && errno != EAGAIN) return -1;
+    if (n < 0) break;
+    off += n;
+  }
+  memmove(s->out.p, s->out.p + off, s->out.len -= off);
+  watch(s);
+  return s->closing && !s->busy && !s->in.len && !s->out.len ? -1 : 0;
+}
+
+// run complete input lines until one is handed over to a worker or the client
+// falls behind reading the replies
+static void process(struct session *s) {
+  char *nl;
+  while (!s->busy && s->out.len < MAX_OUTPUT && s->in.len &&
+         (nl = memchr(s->in.p, '\n', s->in.len))) {
+    size_t n = nl - s->in.p + 1;
+    char *line = strndup(s->in.p, n - 1);
+    memmove(s->in.p, nl + 1, s->in.len -= n);
+    if (heavy(s, line)) {
+      s->busy = 1, s->line = line;
+      submit(s);
+    } else {
+      handle(s, line, &s->out);
+      free(line);
+    }
+  }
+  if (!s->busy && s->in.len > MAX_LINE && !memchr(s->in.p, '\n', s->in.len)) {
+    bprintf(&s->out, "line too long\nerr\n");
+    s->in.len = 0;
+  }
+  if (flush(s) < 0) drop(s);
+}
+
+static void on_accept(void) {
+  int fd;
+  while ((fd = accept4(lfd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+    struct session *s = calloc(1, sizeof(*s));
+    struct epoll_event ev = {EPOLLIN, {.ptr = s}};
+    s->fd = fd, s->events = EPOLLIN;
+    epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+  }
+}
+
+static void on_read(struct session *s) {
+  char tmp[4096];
+  ssize_t n = read(s->fd, tmp, sizeof(tmp));
+  if (n < 0 && (errno == EAGAIN || errno == EINTR)) return;
+  if (n < 0) {
+    drop(s);
+    return;
+  }
+  if (n == 0) {  // half-closed: still answer everything sent before EOF
+    s->closing = 1;
+    if (s->in.len && s->in.p[s->in.len - 1] != '\n') bput(&s->in, "\n", 1);
+    process(s);
+    return;
+  }
+  bput(&s->in, tmp, n);
+  process(s);
+}
+
+static void on_done(void) {
+  uint64_t n;
+  if (read(efd, &n, sizeof(n)) < 0) return;
+  pthread_mutex_lock(&mu);
+  struct session *s = done, *next;
+  done = NULL;
+  pthread_mutex_unlock(&mu);
+  for (; s; s = next) {
+    next = s->next;
+    free(s->line);
+    s->line = NULL, s->busy = 0;
+    if (s->dead) {
+      bury(s);
+      continue;
+    }
+    bput(&s->out, s->reply.p, s->reply.len);
+    s->reply.len = 0;
+    process(s);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int opt, nworkers = sysconf(_SC_NPROCESSORS_ONLN);
+  char *path = "/tmp/tinygamesd.sock", *dict = "../wordle/WORDS.txt";
+  char *bank = NULL;
+  while ((opt = getopt(argc, argv, "p:j:d:b:")) != -1) {
+    switch (opt) {
+      case 'p': path = optarg; break;            // Socket path
+      case 'j': nworkers = atoi(optarg); break;  // Worker threads
+      case 'd': dict = optarg; break;            // Wordle dictionary
+      case 'b': bank = optarg; break;            // Puzzle bank
+      default:
+        fprintf(stderr,
+                "USAGE: %s [-p <path>] [-j <workers>] [-d <dict>] [-b <bank>]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (wordle_load(dict) < 0) perror(dict);
+  if (bank && bank_load(bank) < 0)
+    return fprintf(stderr, "invalid bank: %s\n", bank), 1;
+
+  struct sockaddr_un addr = {.sun_family = AF_UNIX};
+  if (strlen(path) >= sizeof(addr.sun_path))
+    return fprintf(stderr, "socket path too long: %s\n", path), 1;
+  strcpy(addr.sun_path, path);
+  unlink(path);
+  lfd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (lfd < 0 || bind(lfd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(lfd, SOMAXCONN) < 0)
+    return perror(path), 1;
+
+  ep = epoll_create1(EPOLL_CLOEXEC);
+  efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  struct epoll_event lev = {EPOLLIN, {.ptr = &lfd}}, eev = {EPOLLIN, {.ptr = &efd}};
+  epoll_ctl(ep, EPOLL_CTL_ADD, lfd, &lev);
+  epoll_ctl(ep, EPOLL_CTL_ADD, efd, &eev);
+
+  for (int i = 0; i < (nworkers > 0 ? nworkers : 1); i++) {
+    pthread_t t;
+    pthread_create(&t, NULL, worker, NULL);
+    pthread_detach(t);
+  }
+  fprintf(stderr, "listening on %s with %d workers\n", path, nworkers);
+
+  for (;;) {
+    struct epoll_event evs[64];
+    int n = epoll_wait(ep, evs, 64, -1);
+    if (n < 0 && errno != EINTR) return perror("epoll_wait"), 1;
+    for (int i = 0; i < n; i++) {
+      if (evs[i].data.ptr == &lfd) {
+        on_accept();
+      } else if (evs[i].data.ptr == &efd) {
+        on_done();
+      } else {
+        struct session *s = evs[i].data.ptr;
+        // once replies drain, run the lines held back by MAX_OUTPUT
+        if (!s->dead && (evs[i].events & EPOLLOUT)) process(s);
+        // a closing session has read everything, a hangup means nobody will
+        // read the replies either
+        if (!s->dead && s->closing && (evs[i].events & (EPOLLHUP | EPOLLERR)))
+          drop(s);
+        if (!s->dead && (evs[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+          on_read(s);
+      }
+    }
+    while (graveyard) {
+      struct session *s = graveyard;
+      graveyard = s->next;
+      free(s->in.p), free(s->out.p), free(s->reply.p), free(s->line);
+      free(s);
+    }
+  }
+}
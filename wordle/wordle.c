@@ -5,11 +5,16 @@
 #include <string.h>
 #include <time.h>
 
-#define L 64
+#include "tinygames.h"
+
+#define L TG_WORD_LEN
 
 int main(int c, char **v) {
   int w = 5, t = 6, o;
-  char x[L], g[L], *f = "WORDS.txt";
+  char x[L], h[L], *f = "WORDS.txt";
+  const char *g;
+  struct tg_dict d;
+  struct tg_rng r;
   while ((o = getopt(c, v, "w:d:t:")) != -1) {
     switch (o) {
       case 'w': w = atoi(optarg); break;
@@ -19,18 +24,11 @@ int main(int c, char **v) {
   }
   if (w < 1 || w >= L) return fprintf(stderr, "invalid length: %d\n", w), 1;
 
-  FILE *d = fopen(f, "r");
-  if (!d) return perror(f), 1;
+  if (tg_dict_load(&d, f) < 0) return perror(f), 1;
 
-  srand(time(0));
-  int n = 0;
-  while (fgets(x, L, d)) {
-    int l = strlen(x);
-    if (x[l - 1] == '\n') x[--l] = 0;
-    if (l == w && islower(*x) && rand() % ++n == 0) strcpy(g, x);
-  }
-  fclose(d);
-  if (!n) return fprintf(stderr, "No words of length %d\n", w), 1;
+  tg_seed(&r, time(0), 0);
+  if (!(g = tg_wordle_pick(&d, w, &r)))
+    return fprintf(stderr, "No words of length %d\n", w), 1;
 
   printf("Guess the %d-letter word!\n", w);
   for (; t > 0; t--) {
@@ -45,17 +43,8 @@ int main(int c, char **v) {
     }
 
     for (int i = 0; i < w; i++) x[i] = tolower(x[i]);
-    if (!strcmp(x, g)) return printf("Correct! The word was %s.\n", g), 0;
-
-    for (int i = 0; i < w; i++) {
-      if (x[i] == g[i])
-        putchar('#');
-      else if (strchr(g, x[i]))
-        putchar('+');
-      else
-        putchar('.');
-    }
-    putchar('\n');
+    if (tg_wordle_score(x, g, h)) return printf("Correct! The word was %s.\n", g), 0;
+    puts(h);
   }
   printf("Out of tries! The word was %s.\n", g);
   return 0;